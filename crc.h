@@ -27,7 +27,9 @@
 #ifndef CRC_H_
 #define CRC_H_
 
+#include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 
 // Short-term fix to force usage of old ABI when compiled with SDCC v4.2.0
 // (or newer). New ABI passes simple arguments (e.g. one or two 8- or 16-bit
@@ -41,6 +43,116 @@
 #define __stack_args
 #endif
 
+// When building the library with CRC_VARIANT_SUFFIX defined (e.g. to _small),
+// every public symbol is given that suffix, so that libraries built with
+// different algorithm options can all be linked into one program, such as the
+// Test program, for comparison. See CRC_VARIANT_DECLARE() below.
+#ifdef CRC_VARIANT_SUFFIX
+#define CRC_VARIANT_PASTE(name, suffix) name##suffix
+#define CRC_VARIANT_PASTE_X(name, suffix) CRC_VARIANT_PASTE(name, suffix)
+#define CRC_VARIANT_NAME(name) CRC_VARIANT_PASTE_X(name, CRC_VARIANT_SUFFIX)
+#define adler32_update CRC_VARIANT_NAME(adler32_update)
+#define adler32_update_buf CRC_VARIANT_NAME(adler32_update_buf)
+#define crc16_ansi_check CRC_VARIANT_NAME(crc16_ansi_check)
+#define crc16_ansi_correct CRC_VARIANT_NAME(crc16_ansi_correct)
+#define crc16_ansi_memcpy CRC_VARIANT_NAME(crc16_ansi_memcpy)
+#define crc16_ansi_rolling_find CRC_VARIANT_NAME(crc16_ansi_rolling_find)
+#define crc16_ansi_rolling_init CRC_VARIANT_NAME(crc16_ansi_rolling_init)
+#define crc16_ansi_update CRC_VARIANT_NAME(crc16_ansi_update)
+#define crc16_ansi_update_bits CRC_VARIANT_NAME(crc16_ansi_update_bits)
+#define crc16_ansi_update_ram CRC_VARIANT_NAME(crc16_ansi_update_ram)
+#define crc16_ccitt_batch CRC_VARIANT_NAME(crc16_ccitt_batch)
+#define crc16_ccitt_check CRC_VARIANT_NAME(crc16_ccitt_check)
+#define crc16_ccitt_crc32_update_buf CRC_VARIANT_NAME(crc16_ccitt_crc32_update_buf)
+#define crc16_ccitt_memcpy CRC_VARIANT_NAME(crc16_ccitt_memcpy)
+#define crc16_ccitt_update CRC_VARIANT_NAME(crc16_ccitt_update)
+#define crc16_ccitt_update_bits CRC_VARIANT_NAME(crc16_ccitt_update_bits)
+#define crc16_ccitt_update_ram CRC_VARIANT_NAME(crc16_ccitt_update_ram)
+#define crc16_xmodem_block512 CRC_VARIANT_NAME(crc16_xmodem_block512)
+#define crc16_xmodem_check CRC_VARIANT_NAME(crc16_xmodem_check)
+#define crc32_check CRC_VARIANT_NAME(crc32_check)
+#define crc32_memcpy CRC_VARIANT_NAME(crc32_memcpy)
+#define crc32_posix_check CRC_VARIANT_NAME(crc32_posix_check)
+#define crc32_posix_memcpy CRC_VARIANT_NAME(crc32_posix_memcpy)
+#define crc32_posix_update CRC_VARIANT_NAME(crc32_posix_update)
+#define crc32_posix_update_far CRC_VARIANT_NAME(crc32_posix_update_far)
+#define crc32_posix_update_ram CRC_VARIANT_NAME(crc32_posix_update_ram)
+#define crc32_update CRC_VARIANT_NAME(crc32_update)
+#define crc32_update_far CRC_VARIANT_NAME(crc32_update_far)
+#define crc32_update_ram CRC_VARIANT_NAME(crc32_update_ram)
+#define crc7_mmc_update CRC_VARIANT_NAME(crc7_mmc_update)
+#define crc8_1wire_check CRC_VARIANT_NAME(crc8_1wire_check)
+#define crc8_1wire_crc16_ansi_update_buf CRC_VARIANT_NAME(crc8_1wire_crc16_ansi_update_buf)
+#define crc8_1wire_update CRC_VARIANT_NAME(crc8_1wire_update)
+#define crc8_1wire_update_bits CRC_VARIANT_NAME(crc8_1wire_update_bits)
+#define crc8_1wire_update_ram CRC_VARIANT_NAME(crc8_1wire_update_ram)
+#define crc8_autosar_batch CRC_VARIANT_NAME(crc8_autosar_batch)
+#define crc8_autosar_check CRC_VARIANT_NAME(crc8_autosar_check)
+#define crc8_autosar_update CRC_VARIANT_NAME(crc8_autosar_update)
+#define crc8_autosar_update_bits CRC_VARIANT_NAME(crc8_autosar_update_bits)
+#define crc8_j1850_check CRC_VARIANT_NAME(crc8_j1850_check)
+#define crc8_j1850_update CRC_VARIANT_NAME(crc8_j1850_update)
+#define crc8_j1850_update_bits CRC_VARIANT_NAME(crc8_j1850_update_bits)
+#define crc8_j1850_update_ram CRC_VARIANT_NAME(crc8_j1850_update_ram)
+#define crc_far_read CRC_VARIANT_NAME(crc_far_read)
+#define crc_hash16_buf CRC_VARIANT_NAME(crc_hash16_buf)
+#define crc_hash16_lookup CRC_VARIANT_NAME(crc_hash16_lookup)
+#define crc_hash16_str CRC_VARIANT_NAME(crc_hash16_str)
+#define crc_hash8_buf CRC_VARIANT_NAME(crc_hash8_buf)
+#define crc_hash8_lookup CRC_VARIANT_NAME(crc_hash8_lookup)
+#define crc_hash8_str CRC_VARIANT_NAME(crc_hash8_str)
+#define crc_image_verify CRC_VARIANT_NAME(crc_image_verify)
+#define crc_job_ckpt_clear CRC_VARIANT_NAME(crc_job_ckpt_clear)
+#define crc_job_ckpt_load CRC_VARIANT_NAME(crc_job_ckpt_load)
+#define crc_job_ckpt_save CRC_VARIANT_NAME(crc_job_ckpt_save)
+#define crc_job_result CRC_VARIANT_NAME(crc_job_result)
+#define crc_job_resume CRC_VARIANT_NAME(crc_job_resume)
+#define crc_job_start CRC_VARIANT_NAME(crc_job_start)
+#define crc_job_step CRC_VARIANT_NAME(crc_job_step)
+#define crc_lut_ram CRC_VARIANT_NAME(crc_lut_ram)
+#define crc_lut_ram_init CRC_VARIANT_NAME(crc_lut_ram_init)
+#define crc_ram_addr CRC_VARIANT_NAME(crc_ram_addr)
+#define crc_ram_init CRC_VARIANT_NAME(crc_ram_init)
+#define crc_ram_size CRC_VARIANT_NAME(crc_ram_size)
+#define fletcher16_update CRC_VARIANT_NAME(fletcher16_update)
+#define fletcher16_update_buf CRC_VARIANT_NAME(fletcher16_update_buf)
+#endif
+
+// Declare the assembly CRC and checksum functions of a library variant built
+// with CRC_VARIANT_SUFFIX defined to the given suffix, for comparing variants,
+// e.g. CRC_VARIANT_DECLARE(_small) declares crc8_1wire_update_small(), etc.
+// Functions written in C, and the '_ram' functions (which also need the
+// variant's crc_lut_ram_init()), are not included.
+#define CRC_VARIANT_DECLARE(suffix) \
+	extern uint8_t crc8_1wire_update##suffix(uint8_t crc, uint8_t data) __naked __stack_args; \
+	extern uint8_t crc8_j1850_update##suffix(uint8_t crc, uint8_t data) __naked __stack_args; \
+	extern uint8_t crc8_autosar_update##suffix(uint8_t crc, uint8_t data) __naked __stack_args; \
+	extern uint16_t crc16_ansi_update##suffix(uint16_t crc, uint8_t data) __naked __stack_args; \
+	extern uint16_t crc16_ccitt_update##suffix(uint16_t crc, uint8_t data) __naked __stack_args; \
+	extern uint32_t crc32_update##suffix(uint32_t crc, uint8_t data) __naked __stack_args; \
+	extern uint32_t crc32_posix_update##suffix(uint32_t crc, uint8_t data) __naked __stack_args; \
+	extern uint8_t crc7_mmc_update##suffix(uint8_t crc, uint8_t data) __naked __stack_args; \
+	extern uint8_t crc8_1wire_update_bits##suffix(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args; \
+	extern uint8_t crc8_j1850_update_bits##suffix(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args; \
+	extern uint8_t crc8_autosar_update_bits##suffix(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args; \
+	extern uint16_t crc16_ansi_update_bits##suffix(uint16_t crc, uint8_t data, uint8_t nbits) __naked __stack_args; \
+	extern uint16_t crc16_ccitt_update_bits##suffix(uint16_t crc, uint8_t data, uint8_t nbits) __naked __stack_args; \
+	extern uint16_t crc16_ansi_memcpy##suffix(void *dst, const void *src, size_t len, uint16_t crc) __naked __stack_args; \
+	extern uint16_t crc16_ccitt_memcpy##suffix(void *dst, const void *src, size_t len, uint16_t crc) __naked __stack_args; \
+	extern uint32_t crc32_memcpy##suffix(void *dst, const void *src, size_t len, uint32_t crc) __naked __stack_args; \
+	extern uint32_t crc32_posix_memcpy##suffix(void *dst, const void *src, size_t len, uint32_t crc) __naked __stack_args; \
+	extern void crc8_1wire_crc16_ansi_update_buf##suffix(const void *data, size_t len, uint8_t *crc8, uint16_t *crc16) __naked __stack_args; \
+	extern void crc16_ccitt_crc32_update_buf##suffix(const void *data, size_t len, uint16_t *crc16, uint32_t *crc32) __naked __stack_args; \
+	extern void crc8_autosar_batch##suffix(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint8_t *out) __naked __stack_args; \
+	extern void crc16_ccitt_batch##suffix(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint16_t *out) __naked __stack_args; \
+	extern uint16_t crc16_xmodem_block512##suffix(const void *data) __naked __stack_args; \
+	extern uint32_t crc32_update_far##suffix(uint32_t addr, uint32_t len, uint32_t crc) __naked __stack_args; \
+	extern uint32_t crc32_posix_update_far##suffix(uint32_t addr, uint32_t len, uint32_t crc) __naked __stack_args; \
+	extern uint16_t fletcher16_update##suffix(uint16_t sum, uint8_t data) __naked __stack_args; \
+	extern uint32_t adler32_update##suffix(uint32_t sum, uint8_t data) __naked __stack_args; \
+	extern uint16_t fletcher16_update_buf##suffix(const void *data, size_t len, uint16_t sum) __naked __stack_args; \
+	extern uint32_t adler32_update_buf##suffix(const void *data, size_t len, uint32_t sum) __naked __stack_args
+
 // Initial values for the various CRC implementations.
 #define CRC8_1WIRE_INIT ((uint8_t)0x0)
 #define CRC8_J1850_INIT ((uint8_t)0xFF)
@@ -51,6 +163,19 @@
 #define CRC32_INIT ((uint32_t)0xFFFFFFFF)
 #define CRC32_POSIX_INIT ((uint32_t)0x0)
 
+// Identifiers for each CRC type, for use with functions that are able to
+// compute any type of CRC.
+typedef enum {
+	CRC_TYPE_CRC8_1WIRE,
+	CRC_TYPE_CRC8_J1850,
+	CRC_TYPE_CRC8_AUTOSAR,
+	CRC_TYPE_CRC16_ANSI,
+	CRC_TYPE_CRC16_CCITT,
+	CRC_TYPE_CRC16_XMODEM,
+	CRC_TYPE_CRC32,
+	CRC_TYPE_CRC32_POSIX
+} crc_type_t;
+
 // Function-like macros to return the initial value.
 #define crc8_1wire_init() CRC8_1WIRE_INIT
 #define crc8_j1850_init() CRC8_J1850_INIT
@@ -84,9 +209,70 @@
 #define crc32_final(c) ((c) ^ CRC32_XOROUT)
 #define crc32_posix_final(c) ((c) ^ CRC32_POSIX_XOROUT)
 
+// Initial values, and function-like macros to return them and to finalise, for
+// the Fletcher-16 and Adler-32 checksums. These are cheaper to compute than a
+// CRC, but have weaker error detection. Finalisation is a no-op, but is
+// provided for consistency with the CRC types.
+#define FLETCHER16_INIT ((uint16_t)0x0)
+#define ADLER32_INIT ((uint32_t)0x1)
+
+#define fletcher16_init() FLETCHER16_INIT
+#define adler32_init() ADLER32_INIT
+
+#define fletcher16_final(c) (c)
+#define adler32_final(c) (c)
+
+// Initial value, and function-like macros to return it and to finalise, for
+// the CRC7-MMC used by SD/MMC card commands. The 7-bit CRC is held in the
+// least-significant bits of a byte; the last byte of an SD command is
+// (crc7_mmc_final(crc) << 1) | 1.
+#define CRC7_MMC_INIT ((uint8_t)0x0)
+#define CRC7_MMC_XOROUT ((uint8_t)0x0)
+
+#define crc7_mmc_init() CRC7_MMC_INIT
+#define crc7_mmc_final(c) ((c) ^ CRC7_MMC_XOROUT)
+
+// Residue values for each CRC implementation. This is the (non-finalised) CRC
+// value obtained by computing the CRC over a frame of data followed by its
+// finalised CRC, when the frame is intact. The CRC bytes must be in the order
+// they are transmitted: LSB first for CRC8-1WIRE, CRC16-ANSI and CRC32, and
+// MSB first for all others.
+#define CRC8_1WIRE_RESIDUE ((uint8_t)0x0)
+#define CRC8_J1850_RESIDUE ((uint8_t)0xC4)
+#define CRC8_AUTOSAR_RESIDUE ((uint8_t)0x42)
+#define CRC16_ANSI_RESIDUE ((uint16_t)0x0)
+#define CRC16_CCITT_RESIDUE ((uint16_t)0x0)
+#define CRC16_XMODEM_RESIDUE ((uint16_t)0x0)
+#define CRC32_RESIDUE ((uint32_t)0xDEBB20E3)
+#define CRC32_POSIX_RESIDUE ((uint32_t)0xC704DD7B)
+
 // These have the same implementations, just with different initial values, so
 // just alias them to the latter functions.
 #define crc16_xmodem_update crc16_ccitt_update
+#define crc16_xmodem_update_bits crc16_ccitt_update_bits
+#define crc16_xmodem_memcpy crc16_ccitt_memcpy
+#define crc16_xmodem_crc32_update_buf crc16_ccitt_crc32_update_buf
+
+// Check the integrity of a frame of data with its CRC appended, by comparing
+// the CRC of the whole frame with the residue value. The length includes the
+// CRC bytes.
+extern bool crc8_1wire_check(const uint8_t *frame, size_t len);
+extern bool crc8_j1850_check(const uint8_t *frame, size_t len);
+extern bool crc8_autosar_check(const uint8_t *frame, size_t len);
+extern bool crc16_ansi_check(const uint8_t *frame, size_t len);
+extern bool crc16_ccitt_check(const uint8_t *frame, size_t len);
+extern bool crc16_xmodem_check(const uint8_t *frame, size_t len);
+extern bool crc32_check(const uint8_t *frame, size_t len);
+extern bool crc32_posix_check(const uint8_t *frame, size_t len);
+
+// Types for pointers to library functions.
+typedef uint8_t (*crc8_update_func_t)(uint8_t crc, uint8_t data) __stack_args;
+typedef uint16_t (*crc16_update_func_t)(uint16_t crc, uint8_t data) __stack_args;
+typedef uint32_t (*crc32_update_func_t)(uint32_t crc, uint8_t data) __stack_args;
+typedef uint8_t (*crc8_update_bits_func_t)(uint8_t crc, uint8_t data, uint8_t nbits) __stack_args;
+typedef uint16_t (*crc16_update_bits_func_t)(uint16_t crc, uint8_t data, uint8_t nbits) __stack_args;
+typedef uint16_t (*crc16_memcpy_func_t)(void *dst, const void *src, size_t len, uint16_t crc) __stack_args;
+typedef uint32_t (*crc32_memcpy_func_t)(void *dst, const void *src, size_t len, uint32_t crc) __stack_args;
 
 extern uint8_t crc8_1wire_update(uint8_t crc, uint8_t data) __naked __stack_args;
 extern uint8_t crc8_j1850_update(uint8_t crc, uint8_t data) __naked __stack_args;
@@ -96,4 +282,312 @@ extern uint16_t crc16_ccitt_update(uint16_t crc, uint8_t data) __naked __stack_a
 extern uint32_t crc32_update(uint32_t crc, uint8_t data) __naked __stack_args;
 extern uint32_t crc32_posix_update(uint32_t crc, uint8_t data) __naked __stack_args;
 
+extern uint16_t fletcher16_update(uint16_t sum, uint8_t data) __naked __stack_args;
+extern uint32_t adler32_update(uint32_t sum, uint8_t data) __naked __stack_args;
+extern uint8_t crc7_mmc_update(uint8_t crc, uint8_t data) __naked __stack_args;
+
+// Update the checksum with a buffer of data. The checksum argument is the
+// existing value (i.e. from 'init' or previous 'update') and the updated value
+// is returned.
+extern uint16_t fletcher16_update_buf(const void *data, size_t len, uint16_t sum) __naked __stack_args;
+extern uint32_t adler32_update_buf(const void *data, size_t len, uint32_t sum) __naked __stack_args;
+
+// Compute the (finalised) CRC16-XMODEM of a 512-byte block of data, such as an
+// SD card data block. Much faster than calling the 'update' function for each
+// byte, by processing a byte at a time rather than a bit at a time, and (in
+// the faster variants) unrolling the loop for the fixed length.
+extern uint16_t crc16_xmodem_block512(const void *data) __naked __stack_args;
+
+// Update the CRC with between 1 and 8 bits of data, for protocols that are not
+// byte-aligned. The data bits are given in the least-significant bits of the
+// data byte; any other bits are ignored. Bits are processed LSB first for
+// CRC8-1WIRE and CRC16-ANSI, and MSB first (i.e. starting from bit nbits-1)
+// for all others. A bit count of zero leaves the CRC unchanged.
+extern uint8_t crc8_1wire_update_bits(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args;
+extern uint8_t crc8_j1850_update_bits(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args;
+extern uint8_t crc8_autosar_update_bits(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args;
+extern uint16_t crc16_ansi_update_bits(uint16_t crc, uint8_t data, uint8_t nbits) __naked __stack_args;
+extern uint16_t crc16_ccitt_update_bits(uint16_t crc, uint8_t data, uint8_t nbits) __naked __stack_args;
+
+// Copy a buffer of data and update the CRC with it in a single pass. The CRC
+// argument is the existing CRC value (i.e. from 'init' or previous 'update')
+// and the updated value is returned, not finalised.
+extern uint16_t crc16_ansi_memcpy(void *dst, const void *src, size_t len, uint16_t crc) __naked __stack_args;
+extern uint16_t crc16_ccitt_memcpy(void *dst, const void *src, size_t len, uint16_t crc) __naked __stack_args;
+extern uint32_t crc32_memcpy(void *dst, const void *src, size_t len, uint32_t crc) __naked __stack_args;
+extern uint32_t crc32_posix_memcpy(void *dst, const void *src, size_t len, uint32_t crc) __naked __stack_args;
+
+// Update the CRC with a region of data given by a 24-bit address, such as
+// flash memory above the 64KB boundary, which can not be reached by a normal
+// (16-bit) data pointer. Regions may cross 64KB boundaries. Addresses must be
+// below 0x30000. Available in both medium and large memory models.
+extern uint32_t crc32_update_far(uint32_t addr, uint32_t len, uint32_t crc) __naked __stack_args;
+extern uint32_t crc32_posix_update_far(uint32_t addr, uint32_t len, uint32_t crc) __naked __stack_args;
+
+// Update two different types of CRC with a buffer of data in a single pass,
+// reading each byte only once. The CRC values are read from and written back
+// to the variables pointed to, and are not finalised.
+extern void crc8_1wire_crc16_ansi_update_buf(const void *data, size_t len, uint8_t *crc8, uint16_t *crc16) __naked __stack_args;
+extern void crc16_ccitt_crc32_update_buf(const void *data, size_t len, uint16_t *crc16, uint32_t *crc32) __naked __stack_args;
+
+// Compute independent, finalised CRCs for an array of fixed-length records,
+// such as log entries, in a single call, so that the cost of the call, loading
+// the initial value and applying the final XOR is paid once per batch rather
+// than once per record. Record n starts at base + (n * stride) and is rec_len
+// bytes long; its CRC is stored to out[n].
+extern void crc8_autosar_batch(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint8_t *out) __naked __stack_args;
+extern void crc16_ccitt_batch(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint16_t *out) __naked __stack_args;
+
+// Rolling CRC16-ANSI over a fixed-length window of data, for finding frame
+// boundaries in a byte stream. After initialising the table for the window
+// length with crc16_ansi_rolling_init(), compute the CRC of the first window as
+// normal, then advance the window by one byte at a time with
+// crc16_ansi_rolling_update(), giving the byte entering the window and the
+// byte leaving it. The window CRC is not finalised. The table occupies 512
+// bytes of RAM.
+typedef struct {
+	uint16_t out_table[256];
+	size_t window_len;
+} crc16_ansi_rolling_t;
+
+#define crc16_ansi_rolling_update(r, c, in, out) (crc16_ansi_update((c), (in)) ^ (r)->out_table[(out)])
+
+extern void crc16_ansi_rolling_init(crc16_ansi_rolling_t *roll, const size_t window_len);
+extern bool crc16_ansi_rolling_find(const crc16_ansi_rolling_t *roll, const uint8_t *data, const size_t len, size_t *offset);
+
+// Results of attempting to correct errors in a frame.
+typedef enum {
+	CRC_CORRECT_OK,     // Frame was intact; nothing to correct.
+	CRC_CORRECT_FIXED,  // Frame had a single-bit error, which has been fixed.
+	CRC_CORRECT_FAILED  // Frame has an error that could not be corrected.
+} crc_correct_result_t;
+
+// Maximum length (including the CRC) of a frame that crc16_ansi_correct() will
+// attempt to correct. Time taken to locate an error is proportional to the
+// frame length. Must not exceed 4093 bytes, beyond which double-bit errors may
+// be mistaken for single-bit errors. Changing this requires re-building the
+// library.
+#ifndef CRC16_ANSI_CORRECT_MAX_LEN
+#define CRC16_ANSI_CORRECT_MAX_LEN 256
+#endif
+
+// Check the integrity of a frame of data with its CRC appended, and if a
+// single bit is in error, correct it in place.
+extern crc_correct_result_t crc16_ansi_correct(uint8_t *frame, const size_t len);
+
+// State of a resumable CRC job. Treat as opaque; use the crc_job_* functions.
+typedef struct {
+	const uint8_t *data;
+	size_t remaining;
+	uint32_t crc;
+	crc_type_t type;
+} crc_job_t;
+
+// Compute a CRC over a region of data in slices of bounded length, so that a
+// long computation may be spread across idle time or timer interrupts. Note
+// that the job functions reference every CRC type's 'update' function, so all
+// will be linked in when they are used.
+#define crc_job_done(j) ((j)->remaining == 0)
+
+extern void crc_job_start(crc_job_t *job, const crc_type_t type, const void *data, const size_t len);
+extern void crc_job_resume(crc_job_t *job, const void *data, const size_t len);
+extern bool crc_job_step(crc_job_t *job, const size_t max_bytes);
+extern uint32_t crc_job_result(const crc_job_t *job);
+
+// A checkpoint of a CRC job, for storing in non-volatile memory (e.g. data
+// EEPROM) so that a long job interrupted by a reset may be resumed. The offset
+// is the number of bytes of the whole region processed so far, as counted by
+// the application. Checkpoints are kept in a ring of slots, each save going to
+// the next slot, to spread write wear; the newest is identified by its sequence
+// number, and a check value over the slot detects incompletely written slots.
+typedef struct {
+	uint16_t seq;
+	uint32_t offset;
+	uint32_t crc;
+	uint8_t type;
+	uint16_t check;
+} crc_job_ckpt_t;
+
+// Function to write to non-volatile memory. Must write all bytes before
+// returning.
+typedef void (*crc_job_ckpt_write_func_t)(void *dst, const void *src, size_t len);
+
+// Save a checkpoint of the job to the ring of slots, and load the newest valid
+// checkpoint from it (returning false if there is none), setting the job's CRC
+// type and intermediate value; continue the job with crc_job_resume(). Clear
+// the ring once the job has completed, so that its checkpoint is not resumed
+// by a later job.
+extern void crc_job_ckpt_save(crc_job_ckpt_t *ring, const uint8_t ring_len, const crc_job_t *job, const uint32_t offset, crc_job_ckpt_write_func_t write_func);
+extern bool crc_job_ckpt_load(const crc_job_ckpt_t *ring, const uint8_t ring_len, crc_job_t *job, uint32_t *offset);
+extern void crc_job_ckpt_clear(crc_job_ckpt_t *ring, const uint8_t ring_len, crc_job_ckpt_write_func_t write_func);
+
+// Read a region of memory given by a 24-bit address into a buffer. Addresses
+// must be below 0x30000.
+extern void crc_far_read(void *dst, uint32_t addr, size_t len) __naked __stack_args;
+
+// Verify a firmware image against a trailer stamped into flash by the
+// tools/image_stamp.py script. The trailer header is followed by a table of
+// CRC32 values of each block of the image (if the block size is non-zero), and
+// then a CRC32 of the header and table. All values are big-endian.
+#define CRC_IMAGE_MAGIC ((uint32_t)0x43524349) // "CRCI"
+#define CRC_IMAGE_BLOCK_SIZE 1024
+
+typedef struct {
+	uint32_t magic;
+	uint32_t length;
+	uint32_t crc;
+	uint16_t block_size;
+	uint16_t block_count;
+} crc_image_trailer_t;
+
+typedef enum {
+	CRC_IMAGE_VERIFY_FULL,    // Compute the CRC of the whole image in one pass.
+	CRC_IMAGE_VERIFY_BLOCKS   // Check block-by-block, stopping at first bad one.
+} crc_image_verify_mode_t;
+
+typedef enum {
+	CRC_IMAGE_OK,
+	CRC_IMAGE_BAD_TRAILER,    // Trailer is missing, malformed or corrupt.
+	CRC_IMAGE_BAD_CRC         // Image does not match the trailer.
+} crc_image_result_t;
+
+extern crc_image_result_t crc_image_verify(const uint32_t image_addr, const uint32_t trailer_addr, const crc_image_verify_mode_t mode);
+
+// Hash a string (excluding its terminator) or a buffer, such as a command name
+// or an ID, with CRC16-CCITT or CRC8-AUTOSAR. The hash is the finalised CRC.
+extern uint16_t crc_hash16_str(const char *str);
+extern uint16_t crc_hash16_buf(const void *data, const size_t len);
+extern uint8_t crc_hash8_str(const char *str);
+extern uint8_t crc_hash8_buf(const void *data, const size_t len);
+
+// Value of an empty hash table slot, and returned when a hash is not found.
+#define CRC_HASH_EMPTY 0xFF
+
+// Open-addressing hash table, as generated by tools/hashgen.py. Each slot
+// gives the hash of a key and its value (e.g. an index into a table of command
+// handlers). The table length is a power of two up to 256, given as a mask of
+// one less, and the seed determines the slot at which the search for each hash
+// starts; the generator chooses it so that most or all keys are found in the
+// first slot searched.
+typedef struct {
+	uint16_t hash;
+	uint8_t value;
+} crc_hash16_slot_t;
+
+typedef struct {
+	const crc_hash16_slot_t *slots;
+	uint8_t mask;
+	uint8_t seed;
+} crc_hash16_table_t;
+
+typedef struct {
+	uint8_t hash;
+	uint8_t value;
+} crc_hash8_slot_t;
+
+typedef struct {
+	const crc_hash8_slot_t *slots;
+	uint8_t mask;
+	uint8_t seed;
+} crc_hash8_table_t;
+
+// Find the value for a hash in a table, or CRC_HASH_EMPTY if it is not present.
+// As an unknown key may have the same hash as a known one, compare the key
+// with that of the value found if this matters.
+extern uint8_t crc_hash16_lookup(const crc_hash16_table_t *table, const uint16_t hash);
+extern uint8_t crc_hash8_lookup(const crc_hash8_table_t *table, const uint8_t hash);
+
+// Lookup table in RAM, built at run-time by crc_lut_ram_init() for the given
+// CRC type, and used by the '_ram' update functions. This gives the speed of a
+// lookup table without using flash for tables, for any CRC type. Only one
+// table exists, so only one CRC type may be used with these functions at a
+// time, and the table must have been built for that type before use. If the
+// library is built with CRC_LUT_RAM_ADDR defined, the table is placed at that
+// address; when below 0x100, shorter and faster addressing modes are used.
+// CRC8-SAE-J1850 and CRC8-AUTOSAR share a function, as do CRC16-CCITT and
+// CRC16-XMODEM; the table alone determines the polynomial.
+#define CRC_LUT_RAM_SIZE 64
+
+extern uint8_t crc_lut_ram[CRC_LUT_RAM_SIZE];
+
+extern void crc_lut_ram_init(const crc_type_t type);
+extern uint8_t crc8_1wire_update_ram(uint8_t crc, uint8_t data) __naked __stack_args;
+extern uint8_t crc8_j1850_update_ram(uint8_t crc, uint8_t data) __naked __stack_args;
+extern uint16_t crc16_ansi_update_ram(uint16_t crc, uint8_t data) __naked __stack_args;
+extern uint16_t crc16_ccitt_update_ram(uint16_t crc, uint8_t data) __naked __stack_args;
+extern uint32_t crc32_update_ram(uint32_t crc, uint8_t data) __naked __stack_args;
+extern uint32_t crc32_posix_update_ram(uint32_t crc, uint8_t data) __naked __stack_args;
+
+#define crc8_autosar_update_ram crc8_j1850_update_ram
+#define crc16_xmodem_update_ram crc16_ccitt_update_ram
+
+// Copy the library assembly functions to RAM so they may be executed from
+// there (e.g. while flash is being programmed). Only available when the
+// library is built with EXECUTE_FROM_RAM defined. Use crc_ram_func() to
+// obtain a pointer to the RAM copy of a function, giving the function pointer
+// type and the function, e.g.:
+// f = crc_ram_func(crc32_update_func_t, crc32_update);
+#define crc_ram_func(t, f) ((t)crc_ram_addr((uint16_t)(f)))
+
+extern size_t crc_ram_size(void);
+extern bool crc_ram_init(void *buf, const size_t buf_len);
+extern uint16_t crc_ram_addr(const uint16_t func_addr);
+
+/******************************************************************************/
+
+// Optional inline forms of the CRC8 and CRC16 update functions, for use in
+// tight loops where the overhead of calling a library function (pushing args,
+// call and return) is a significant proportion of the time taken. To use,
+// define CRC_INLINE before including this header. These give the same results
+// as the corresponding non-inline functions, and are always the unrolled
+// bitwise algorithm.
+//
+// They are written in plain C rather than inline assembly, so that the
+// compiler can keep the CRC in a register for the whole of the calling loop,
+// and so that they are reentrant (unlike inline assembly, which would have to
+// pass the CRC through a static variable).
+
+#ifdef CRC_INLINE
+
+#define CRC_INLINE_X8(s) s s s s s s s s
+
+// One bit of the bitwise algorithm, for reflected (shifting right) and normal
+// (shifting left) CRCs respectively; 'top' is the MSB of the CRC's width.
+#define CRC_INLINE_BIT_R(c, poly) c = ((c) & 1) ? (((c) >> 1) ^ (poly)) : ((c) >> 1);
+#define CRC_INLINE_BIT_L(c, poly, top) c = ((c) & (top)) ? (((c) << 1) ^ (poly)) : ((c) << 1);
+
+static inline uint8_t crc8_1wire_update_inline(uint8_t crc, uint8_t data) {
+	crc ^= data;
+	CRC_INLINE_X8(CRC_INLINE_BIT_R(crc, 0x8C))
+	return crc;
+}
+
+static inline uint8_t crc8_j1850_update_inline(uint8_t crc, uint8_t data) {
+	crc ^= data;
+	CRC_INLINE_X8(CRC_INLINE_BIT_L(crc, 0x1D, 0x80))
+	return crc;
+}
+
+static inline uint8_t crc8_autosar_update_inline(uint8_t crc, uint8_t data) {
+	crc ^= data;
+	CRC_INLINE_X8(CRC_INLINE_BIT_L(crc, 0x2F, 0x80))
+	return crc;
+}
+
+static inline uint16_t crc16_ansi_update_inline(uint16_t crc, uint8_t data) {
+	crc ^= data;
+	CRC_INLINE_X8(CRC_INLINE_BIT_R(crc, 0xA001))
+	return crc;
+}
+
+static inline uint16_t crc16_ccitt_update_inline(uint16_t crc, uint8_t data) {
+	crc ^= (uint16_t)data << 8;
+	CRC_INLINE_X8(CRC_INLINE_BIT_L(crc, 0x1021, 0x8000))
+	return crc;
+}
+
+#define crc16_xmodem_update_inline crc16_ccitt_update_inline
+
+#endif
+
 #endif // CRC_H_
@@ -0,0 +1,81 @@
+/*******************************************************************************
+ *
+ * adler32.c - Adler-32 checksum implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// Adler-32
+// Modulus: 65521
+// Initial value: 0x00000001
+// XOR out: 0x00000000
+
+uint32_t adler32_update(uint32_t sum, uint8_t data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)sum;
+	(void)data;
+
+	// For return value/arg: 0xAABBCCDD
+	// x = 0xCCDD (first sum, 'A')
+	// y = 0xAABB (second sum, 'B')
+
+	__asm
+		; Add the data byte to the first sum (LSW), putting the result in X.
+		ld a, (ASM_ARGS_SP_OFFSET+4, sp)
+		add a, (ASM_ARGS_SP_OFFSET+3, sp)
+		ld xl, a
+		ld a, (ASM_ARGS_SP_OFFSET+2, sp)
+		adc a, #0
+		ld xh, a
+
+		; Take the result modulo 65521. If the addition overflowed, or the
+		; result is 65521 or more, subtract 65521. This is done by adding 15,
+		; because 65536 - 65521 = 15, and any overflow from that is discarded.
+		jrc 0001$
+		cpw x, #65521
+		jrult 0002$
+	0001$:
+		addw x, #15
+	0002$:
+
+		; Add the new first sum to the second sum (MSW), putting the result in
+		; Y, and take it modulo 65521 the same way.
+		ldw (ASM_ARGS_SP_OFFSET+2, sp), x
+		ldw y, (ASM_ARGS_SP_OFFSET+0, sp)
+		addw y, (ASM_ARGS_SP_OFFSET+2, sp)
+		jrc 0003$
+		cpw y, #65521
+		jrult 0004$
+	0003$:
+		addw y, #15
+	0004$:
+
+		; The X and Y regs now contain updated checksum value, so leave them
+		; there as function return value.
+		ASM_RETURN
+	__endasm;
+}
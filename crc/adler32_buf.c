@@ -0,0 +1,113 @@
+/*******************************************************************************
+ *
+ * adler32_buf.c - Adler-32 checksum buffer implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// Adler-32
+// Modulus: 65521
+// Initial value: 0x00000001
+// XOR out: 0x00000000
+
+uint32_t adler32_update_buf(const void *data, size_t len, uint32_t sum) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)data;
+	(void)len;
+	(void)sum;
+
+	// For return value/arg: 0xAABBCCDD
+	// x = 0xCCDD (first sum, 'A')
+	// y = 0xAABB (second sum, 'B')
+
+	__asm
+		; Load the second sum (MSW) into Y. It is kept there for the duration
+		; of the loop, while the first sum is worked on from the stack.
+		ldw y, (ASM_ARGS_SP_OFFSET+4, sp)
+
+		; Load length from stack, and if it is zero, skip straight to the end.
+		ldw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		jreq 0005$
+
+		; Add the data pointer to the length to give the data end address, and
+		; put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw (ASM_ARGS_SP_OFFSET+2, sp), x
+
+		; Load data pointer into X.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+
+	0001$:
+		; Load a byte from the data, and advance the data pointer. Save the
+		; pointer on the stack while the X reg is used to work on the first
+		; sum. Note: this moves stack offset of args by 2 bytes.
+		ld a, (x)
+		incw x
+		pushw x
+
+		; Add the data byte to the first sum (LSW), putting the result in X.
+		add a, (ASM_ARGS_SP_OFFSET+2+7, sp)
+		ld xl, a
+		ld a, (ASM_ARGS_SP_OFFSET+2+6, sp)
+		adc a, #0
+		ld xh, a
+
+		; Take the result modulo 65521. If the addition overflowed, or the
+		; result is 65521 or more, subtract 65521. This is done by adding 15,
+		; because 65536 - 65521 = 15, and any overflow from that is discarded.
+		jrc 0002$
+		cpw x, #65521
+		jrult 0003$
+	0002$:
+		addw x, #15
+	0003$:
+
+		; Put the new first sum back on the stack, then add it to the second
+		; sum, and take that modulo 65521 the same way.
+		ldw (ASM_ARGS_SP_OFFSET+2+6, sp), x
+		addw y, (ASM_ARGS_SP_OFFSET+2+6, sp)
+		jrc 0004$
+		cpw y, #65521
+		jrult 0006$
+	0004$:
+		addw y, #15
+	0006$:
+
+		; Restore the data pointer, and loop around if it has not yet reached
+		; the end address.
+		popw x
+		cpw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		jrne 0001$
+
+	0005$:
+		; Load the first sum from the stack into X reg. The X and Y regs now
+		; contain the checksum value for function return value.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+
+		ASM_RETURN
+	__endasm;
+}
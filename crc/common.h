@@ -30,9 +30,46 @@
 #ifdef __SDCC_MODEL_LARGE
 #define ASM_ARGS_SP_OFFSET 4
 #define ASM_RETURN retf
+#define ASM_JUMP jpf
 #else
 #define ASM_ARGS_SP_OFFSET 3
 #define ASM_RETURN ret
+#define ASM_JUMP jp
+#endif
+
+// Relative jumps only reach -128 to +127 bytes, which is too short to close the
+// loop of some functions that process a data byte per iteration when their bit
+// loop is unrolled. Those functions then instead close the loop with an
+// absolute jump (ASM_JUMP). Because that is not position-independent, they keep
+// the bit loop rolled when building for execution from RAM (see below).
+#if defined(ALGORITHM_BITWISE_UNROLLED) && !defined(EXECUTE_FROM_RAM)
+#define ALGORITHM_BITWISE_UNROLLED_LONG
+#endif
+
+// When building for execution from RAM, place all assembly code in a separate
+// segment, so that it may be copied to RAM at run-time by crc_ram_init(). This
+// only works because the assembly code then exclusively uses relative jumps, so
+// is position-independent. Lookup tables are made non-const so that they are
+// placed in RAM (initialised by start-up code) rather than in flash, which
+// cannot be read while it is being programmed.
+#ifdef EXECUTE_FROM_RAM
+#pragma codeseg CRC_RAM
+#define LUT_CONST
+#else
+#define LUT_CONST const
+#endif
+
+// Location of the RAM lookup table used by the '_ram' functions. When it is
+// placed at a fixed address (see crc_lut_ram.c), the constant address is used
+// directly, so that the assembler can use short offset addressing modes when
+// the address is below 0x100. In a suffixed library variant, the symbol name
+// carries the suffix too (see crc.h).
+#ifdef CRC_LUT_RAM_ADDR
+#define CRC_LUT_RAM_SYM CRC_LUT_RAM_ADDR
+#elif defined(CRC_VARIANT_SUFFIX)
+#define CRC_LUT_RAM_SYM CRC_VARIANT_NAME(_crc_lut_ram)
+#else
+#define CRC_LUT_RAM_SYM _crc_lut_ram
 #endif
 
 #endif // COMMON_H_
@@ -0,0 +1,44 @@
+/*******************************************************************************
+ *
+ * crc16_ansi_check.c - CRC16-ANSI frame check implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// CRC16-ANSI (aka IBM, Modbus, USB)
+// Residue: 0x0000
+// CRC byte order in frame: LSB first
+
+bool crc16_ansi_check(const uint8_t *frame, size_t len) {
+	uint16_t crc = crc16_ansi_init();
+
+	// Compute the CRC over the entire frame, including the CRC bytes at the
+	// end. If the frame is intact, this will always give the residue value.
+	while(len--) crc = crc16_ansi_update(crc, *frame++);
+
+	return (crc == CRC16_ANSI_RESIDUE);
+}
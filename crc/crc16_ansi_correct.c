@@ -0,0 +1,71 @@
+/*******************************************************************************
+ *
+ * crc16_ansi_correct.c - CRC16-ANSI single-bit error correction
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// When a frame (data followed by its CRC) has a single bit in error, the CRC
+// computed over the whole frame is no longer the residue (which for CRC16-ANSI
+// is zero), but instead is a 'syndrome' value that depends only on the
+// position of the bad bit, counting back from the end of the frame. The
+// syndrome for the last bit of the frame is the polynomial value, and that for
+// each earlier bit is obtained by shifting the previous one through the CRC
+// shift register once more. So, rather than storing a table of syndromes for
+// every bit position (which for even modest frame lengths would need several
+// kilobytes), the shift register is stepped back through the frame until the
+// syndrome is matched.
+//
+// CRC16-ANSI has a Hamming distance of 4 for frames of this size, so any
+// single-bit error can be corrected, and any double-bit error is detected
+// (i.e. never mistaken for a single-bit error). Three or more bad bits may be
+// mis-corrected.
+
+crc_correct_result_t crc16_ansi_correct(uint8_t *frame, const size_t len) {
+	uint16_t syndrome = crc16_ansi_init();
+	uint16_t crc = 1;
+	size_t pos;
+
+	for(size_t i = 0; i < len; i++) {
+		syndrome = crc16_ansi_update(syndrome, frame[i]);
+	}
+
+	if(syndrome == CRC16_ANSI_RESIDUE) return CRC_CORRECT_OK;
+	if(len > CRC16_ANSI_CORRECT_MAX_LEN) return CRC_CORRECT_FAILED;
+
+	// Bits are counted from the last one of the frame, with the frame having
+	// been processed LSB first, so position 0 is the MSB of the last byte.
+	for(pos = 0; pos < (len * 8); pos++) {
+		crc = (crc & 1 ? (crc >> 1) ^ 0xA001 : crc >> 1);
+		if(crc == syndrome) {
+			frame[len - 1 - (pos / 8)] ^= (uint8_t)(0x80 >> (pos % 8));
+			return CRC_CORRECT_FIXED;
+		}
+	}
+
+	return CRC_CORRECT_FAILED;
+}
@@ -0,0 +1,141 @@
+/*******************************************************************************
+ *
+ * crc16_ansi_memcpy.c - CRC16-ANSI fused copy and CRC implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC16-ANSI (aka IBM, Modbus, USB)
+// Polynomial: x^16 + x^15 + x^2 + 1 (0xA001, reversed)
+// Initial value: 0xFFFF
+// XOR out: 0x0000
+
+uint16_t crc16_ansi_memcpy(void *dst, const void *src, size_t len, uint16_t crc) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)dst;
+	(void)src;
+	(void)len;
+	(void)crc;
+
+	// For return value/arg: 0xAABB
+	// x = 0xAABB (xh = 0xAA, xl = 0xBB)
+
+	__asm
+		; Load length from stack, and if it is zero, skip straight to the end.
+		ldw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		jreq 0003$
+
+		; Add the source pointer to the length to give the source end address,
+		; and put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		ldw (ASM_ARGS_SP_OFFSET+4, sp), x
+
+		; Load source pointer into X and destination pointer into Y.
+		ldw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		ldw y, (ASM_ARGS_SP_OFFSET+0, sp)
+
+	0001$:
+		; Copy a byte from source to destination, and advance both pointers.
+		; The data byte remains in the A register.
+		ld a, (x)
+		ld (y), a
+		incw x
+		incw y
+
+		; Save the pointers on the stack while the X reg is used to work on the
+		; CRC. Note: this moves stack offset of args by 4 bytes.
+		pushw x
+		pushw y
+
+		; XOR the LSB of the CRC with data byte, and put it back in the CRC.
+		xor a, (ASM_ARGS_SP_OFFSET+4+7, sp)
+		ld (ASM_ARGS_SP_OFFSET+4+7, sp), a
+
+		; Load CRC variable from stack into X register for further work.
+		ldw x, (ASM_ARGS_SP_OFFSET+4+6, sp)
+
+	.macro crc16_ansi_memcpy_shift_xor skip_lbl
+			; Shift CRC value right by one bit.
+			srlw x
+
+			; Jump if least-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			rrwa x                       ; put LSB of crc into a
+			xor a, #0x01                 ; xor it with 0x01
+			rrwa x                       ; put MSB of crc into a
+			xor a, #0xA0                 ; xor it with 0xA0
+			rrwa x                       ; put counter back into a
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED
+
+		crc16_ansi_memcpy_shift_xor 0011$
+		crc16_ansi_memcpy_shift_xor 0012$
+		crc16_ansi_memcpy_shift_xor 0013$
+		crc16_ansi_memcpy_shift_xor 0014$
+		crc16_ansi_memcpy_shift_xor 0015$
+		crc16_ansi_memcpy_shift_xor 0016$
+		crc16_ansi_memcpy_shift_xor 0017$
+		crc16_ansi_memcpy_shift_xor 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0002$:
+
+		crc16_ansi_memcpy_shift_xor 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0002$
+
+#endif
+
+		; Put the updated CRC value back on the stack.
+		ldw (ASM_ARGS_SP_OFFSET+4+6, sp), x
+
+		; Restore the pointers, and loop around again if the source pointer has
+		; not yet reached the end address.
+		popw y
+		popw x
+		cpw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		jrne 0001$
+
+	0003$:
+		; Load the CRC value from the stack into X reg for function return
+		; value.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,92 @@
+/*******************************************************************************
+ *
+ * crc16_ansi_rolling.c - CRC16-ANSI rolling (sliding window) CRC
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// The CRC of a window of data can be advanced by one byte by updating it with
+// the incoming byte as normal, then cancelling the effect of the outgoing byte
+// (the first byte of the window before it moved). Because the CRC is linear,
+// the effect of the outgoing byte depends only on its value and the window
+// length. It is the CRC of that byte followed by as many zero bytes as the
+// window length, starting from zero. The effect of the initial value also has
+// to be moved back by one byte, which is a constant for a given window length,
+// so it is folded into every table entry.
+
+static uint16_t crc16_ansi_rolling_zeros(uint16_t crc, size_t n) {
+	while(n--) crc = crc16_ansi_update(crc, 0);
+	return crc;
+}
+
+void crc16_ansi_rolling_init(crc16_ansi_rolling_t *roll, const size_t window_len) {
+	uint16_t crc;
+
+	roll->window_len = window_len;
+
+	// Initial value correction for moving the start of the window along by
+	// one byte. This is entry zero, as an outgoing byte of zero has no other
+	// effect.
+	crc = crc16_ansi_rolling_zeros(CRC16_ANSI_INIT, window_len);
+	roll->out_table[0] = crc ^ crc16_ansi_update(crc, 0);
+
+	// Only the effect of each single bit value has to be computed the long
+	// way; all other entries are then built up from those by XOR, doubling
+	// the number of filled entries each time.
+	for(uint8_t bit = 0; bit < 8; bit++) {
+		uint8_t m = (uint8_t)(1 << bit);
+		crc = crc16_ansi_rolling_zeros(crc16_ansi_update(0, m), window_len);
+		for(uint8_t i = 0; i < m; i++) {
+			roll->out_table[m | i] = roll->out_table[i] ^ crc;
+		}
+	}
+}
+
+bool crc16_ansi_rolling_find(const crc16_ansi_rolling_t *roll, const uint8_t *data, const size_t len, size_t *offset) {
+	uint16_t crc = crc16_ansi_init();
+	size_t i;
+
+	if(len < roll->window_len) return false;
+
+	// Compute the CRC of the first window the normal way.
+	for(i = 0; i < roll->window_len; i++) {
+		crc = crc16_ansi_update(crc, data[i]);
+	}
+
+	// Check for a valid frame (i.e. one that gives the residue value), and if
+	// there is not one, move the window along by one byte and try again.
+	for(i = 0; ; i++) {
+		if(crc == CRC16_ANSI_RESIDUE) {
+			*offset = i;
+			return true;
+		}
+		if(i + roll->window_len >= len) break;
+		crc = crc16_ansi_rolling_update(roll, crc, data[i + roll->window_len], data[i]);
+	}
+
+	return false;
+}
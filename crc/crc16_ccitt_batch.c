@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *
+ * crc16_ccitt_batch.c - CRC16-CCITT batch implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC16-CCITT
+// Polynomial: x^16 + x^12 + x^5 + 1 (0x1021, normal)
+// Initial value: 0xFFFF
+// XOR out: 0x0000
+
+void crc16_ccitt_batch(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint16_t *out) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)base;
+	(void)stride;
+	(void)rec_len;
+	(void)count;
+	(void)out;
+
+	// For CRC value: 0xAABB
+	// y = 0xAABB (yh = 0xAA, yl = 0xBB)
+
+	__asm
+		; Load record count from stack, and if it is zero, there is nothing to
+		; do, so return straight away.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		jrne 0001$
+		ASM_RETURN
+
+	0001$:
+		; Add the record length to the record start address to give the record
+		; end address, and push it on the stack. Note: this moves stack offset
+		; of args by 2 bytes.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		addw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		pushw x
+
+		; Load record start address into X, and the initial CRC value into Y.
+		; Unlike the 'update' function, the CRC is kept in the Y reg, because
+		; only the X reg can be compared with the end address on the stack. If
+		; the record is empty, skip to storing the CRC.
+		ldw x, (ASM_ARGS_SP_OFFSET+2+0, sp)
+		ldw y, #0xFFFF
+		cpw x, (1, sp)
+		jreq 0004$
+
+	0002$:
+		; XOR the MSB of the CRC with data byte.
+		ld a, yh
+		xor a, (x)
+		ld yh, a
+
+	.macro crc16_ccitt_batch_shift_xor skip_lbl
+			; Shift CRC value left by one bit.
+			sllw y
+
+			; Jump if most-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			rrwa y                       ; put LSB of crc into a
+			xor a, #0x21                 ; xor it with 0x21
+			rrwa y                       ; put MSB of crc into a
+			xor a, #0x10                 ; xor it with 0x10
+			rrwa y                       ; put counter back into a
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc16_ccitt_batch_shift_xor 0011$
+		crc16_ccitt_batch_shift_xor 0012$
+		crc16_ccitt_batch_shift_xor 0013$
+		crc16_ccitt_batch_shift_xor 0014$
+		crc16_ccitt_batch_shift_xor 0015$
+		crc16_ccitt_batch_shift_xor 0016$
+		crc16_ccitt_batch_shift_xor 0017$
+		crc16_ccitt_batch_shift_xor 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0003$:
+
+		crc16_ccitt_batch_shift_xor 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0003$
+
+#endif
+
+		; Advance the data pointer, and loop around if it has not yet reached
+		; the record end address.
+		incw x
+		cpw x, (1, sp)
+		jrne 0002$
+
+	0004$:
+		; CRC16-CCITT has no final XOR, so discard the record end address from
+		; the stack, and store the CRC to the output array, advancing the
+		; output pointer.
+		popw x
+		ldw x, (ASM_ARGS_SP_OFFSET+8, sp)
+		ldw (x), y
+		incw x
+		incw x
+		ldw (ASM_ARGS_SP_OFFSET+8, sp), x
+
+		; Advance the record start address by the stride.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		addw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		ldw (ASM_ARGS_SP_OFFSET+0, sp), x
+
+		; Decrement the record count, and loop around if it is not zero.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		decw x
+		ldw (ASM_ARGS_SP_OFFSET+6, sp), x
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+		jreq 0005$
+		ASM_JUMP 0001$
+	0005$:
+#else
+		jrne 0001$
+#endif
+
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * crc16_ccitt_bits.c - CRC16-CCITT bit-granular implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC16-CCITT
+// Polynomial: x^16 + x^12 + x^5 + 1 (0x1021, normal)
+// Initial value: 0xFFFF
+// XOR out: 0x0000
+
+uint16_t crc16_ccitt_update_bits(uint16_t crc, uint8_t data, uint8_t nbits) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)crc;
+	(void)data;
+	(void)nbits;
+
+	// For return value/arg: 0xAABB
+	// x = 0xAABB (xh = 0xAA, xl = 0xBB)
+
+	__asm
+		; Load bit count from stack, and if it is zero, skip straight to the
+		; end.
+		ld a, (ASM_ARGS_SP_OFFSET+3, sp)
+		jreq 0003$
+
+		; Align the data bits to be used with the most-significant end of the
+		; byte, by shifting the data byte left by (8 - nbits) bits. Rather than
+		; shifting in a loop, test each bit of the shift count and do a shift
+		; of 1, 2 and 4 bits accordingly, so it takes near-constant time. Any
+		; unused bits are shifted out.
+		ld a, #8
+		sub a, (ASM_ARGS_SP_OFFSET+3, sp)
+		ld yl, a
+		ld a, (ASM_ARGS_SP_OFFSET+2, sp)
+		srlw y
+		jrnc 0004$
+		sll a
+	0004$:
+		srlw y
+		jrnc 0005$
+		sll a
+		sll a
+	0005$:
+		srlw y
+		jrnc 0006$
+		swap a
+		and a, #0xF0
+	0006$:
+
+		; XOR the MSB of the CRC with the data bits, and put it back in the
+		; CRC.
+		xor a, (ASM_ARGS_SP_OFFSET+0, sp)
+		ld (ASM_ARGS_SP_OFFSET+0, sp), a
+
+		; Load CRC variable from stack into X register for further work.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+
+	.macro crc16_ccitt_update_bits_shift_xor skip_lbl
+			; Shift CRC value left by one bit.
+			sllw x
+
+			; Jump if most-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			rrwa x                       ; put LSB of crc into a
+			xor a, #0x21                 ; xor it with 0x21
+			rrwa x                       ; put MSB of crc into a
+			xor a, #0x10                 ; xor it with 0x10
+			rrwa x                       ; restore a
+
+		skip_lbl:
+	.endm
+
+		; Loop once for each bit, using the bit count on the stack as the
+		; counter. Unrolling is not possible, as the number of bits varies.
+	0001$:
+
+		crc16_ccitt_update_bits_shift_xor 0002$
+
+		; Decrement counter and loop around if it is not zero.
+		dec (ASM_ARGS_SP_OFFSET+3, sp)
+		jrne 0001$
+
+		; The X reg now contains updated CRC value, so leave it there as
+		; function return value.
+		ASM_RETURN
+
+	0003$:
+		; Nothing to do, so load the unchanged CRC value from stack into X reg
+		; for function return value.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+
+		ASM_RETURN
+	__endasm;
+}
+
+/******************************************************************************/
+
+// CRC16-XMODEM
+// Polynomial: x^16 + x^12 + x^5 + 1 (0x1021, normal)
+// Initial value: 0x0000
+
+// NOTE: same implementation as CCITT, but with different initial value.
@@ -0,0 +1,231 @@
+/*******************************************************************************
+ *
+ * crc16_ccitt_crc32.c - CRC16-CCITT and CRC32 dual implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC16-CCITT
+// Polynomial: x^16 + x^12 + x^5 + 1 (0x1021, normal)
+// Initial value: 0xFFFF
+// XOR out: 0x0000
+
+// CRC32 (aka GZIP, PKZIP, PNG, ZMODEM)
+// Polynomial: x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x + 1 (0xEDB88320, reversed)
+// Initial value: 0xFFFFFFFF
+// XOR out: 0xFFFFFFFF
+
+void crc16_ccitt_crc32_update_buf(const void *data, size_t len, uint16_t *crc16, uint32_t *crc32) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)data;
+	(void)len;
+	(void)crc16;
+	(void)crc32;
+
+	// For CRC32 value: 0xAABBCCDD
+	// x = 0xCCDD (xh = 0xCC, xl = 0xDD)
+	// y = 0xAABB (yh = 0xAA, yl = 0xBB)
+
+	__asm
+		; Load length from stack, and if it is zero, there is nothing to do, so
+		; return straight away.
+		ldw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		jrne 0003$
+		ASM_RETURN
+
+	0003$:
+		; Add the data pointer to the length to give the data end address, and
+		; put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw (ASM_ARGS_SP_OFFSET+2, sp), x
+
+		; Load the CRC16 value from where its pointer points, and put it on the
+		; stack as a local variable. Note: this moves stack offset of args by 2
+		; bytes.
+		ldw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		ldw x, (x)
+		pushw x
+
+		; Load the CRC32 value from where its pointer points into the X & Y
+		; regs. The CRC32 is kept in registers for the duration of the loop,
+		; except that the LSW is saved on the stack while the X reg is used for
+		; other work. Note: this moves stack offset of args by a further 2 bytes.
+		ldw x, (ASM_ARGS_SP_OFFSET+2+6, sp)
+		ldw y, x
+		ldw y, (y)
+		ldw x, (2, x)
+		pushw x
+
+	0001$:
+		; Load a byte from the data, and advance the data pointer.
+		ldw x, (ASM_ARGS_SP_OFFSET+4+0, sp)
+		ld a, (x)
+		incw x
+		ldw (ASM_ARGS_SP_OFFSET+4+0, sp), x
+
+		; XOR the LSB of the CRC32 with the data byte, and put it back. Keep a
+		; copy of the data byte in the XL reg, as the CRC16 also needs it.
+		ld xl, a
+		xor a, (2, sp)
+		ld (2, sp), a
+
+		; XOR the MSB of the CRC16 with the data byte, and put it back. Then
+		; load the CRC16 into the X reg for further work.
+		ld a, xl
+		xor a, (3, sp)
+		ld (3, sp), a
+		ldw x, (3, sp)
+
+	.macro crc16_ccitt_crc32_update_buf_shift_xor_16 skip_lbl
+			; Shift CRC16 value left by one bit.
+			sllw x
+
+			; Jump if most-significant bit of CRC16 is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC16 value with the polynomial value.
+			rrwa x                       ; put LSB of crc into a
+			xor a, #0x21                 ; xor it with 0x21
+			rrwa x                       ; put MSB of crc into a
+			xor a, #0x10                 ; xor it with 0x10
+			rrwa x                       ; put counter back into a
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0011$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0012$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0013$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0014$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0015$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0016$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0017$
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0002$:
+
+		crc16_ccitt_crc32_update_buf_shift_xor_16 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0002$
+
+#endif
+
+		; Put the updated CRC16 value back on the stack, then restore the LSW
+		; of the CRC32 to the X reg. Note: this moves stack offset of args and
+		; the CRC16 back by 2 bytes.
+		ldw (3, sp), x
+		popw x
+
+	.macro crc16_ccitt_crc32_update_buf_shift_xor_32 skip_lbl
+			; Shift CRC32 value right by one bit.
+			srlw y
+			rrcw x
+
+			; Jump if least-significant bit of CRC32 is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC32 value with the polynomial value.
+			rrwa x
+			xor a, #0x20
+			rrwa x
+			xor a, #0x83
+			rrwa x
+			rrwa y
+			xor a, #0xB8
+			rrwa y
+			xor a, #0xED
+			rrwa y
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0021$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0022$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0023$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0024$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0025$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0026$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0027$
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0028$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0004$:
+
+		crc16_ccitt_crc32_update_buf_shift_xor_32 0021$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0004$
+
+#endif
+
+		; Save the LSW of the CRC32 on the stack again, then loop around if the
+		; data pointer has not yet reached the end address.
+		pushw x
+		ldw x, (ASM_ARGS_SP_OFFSET+4+0, sp)
+		cpw x, (ASM_ARGS_SP_OFFSET+4+2, sp)
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+		jreq 0005$
+		ASM_JUMP 0001$
+	0005$:
+#else
+		jrne 0001$
+#endif
+
+		; Write the updated CRC32 value back to where its pointer points. The
+		; MSW is still in the Y reg, and the LSW is on the stack.
+		ldw x, (ASM_ARGS_SP_OFFSET+4+6, sp)
+		ldw (x), y
+		ldw y, (1, sp)
+		ldw (2, x), y
+
+		; Write the updated CRC16 value back to where its pointer points.
+		ldw x, (ASM_ARGS_SP_OFFSET+4+4, sp)
+		ldw y, (3, sp)
+		ldw (x), y
+
+		; Discard the local variables from the stack.
+		addw sp, #4
+
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,86 @@
+/*******************************************************************************
+ *
+ * crc16_ccitt_ram.c - CRC16-CCITT RAM lookup table implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC16-CCITT
+// Polynomial: x^16 + x^12 + x^5 + 1 (0x1021, normal)
+// Initial value: 0xFFFF
+// XOR out: 0x0000
+//
+// Uses the lookup table built in RAM by crc_lut_ram_init(CRC_TYPE_CRC16_CCITT)
+// (or CRC_TYPE_CRC16_XMODEM, which is identical).
+
+uint16_t crc16_ccitt_update_ram(uint16_t crc, uint8_t data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)crc;
+	(void)data;
+
+	// For return value/arg: 0xAABB
+	// x = 0xAABB (xh = 0xAA, xl = 0xBB)
+
+	__asm
+		; Load CRC variable from stack into Y register, and XOR the MSB of the
+		; CRC with the data byte. The X register is used for the LUT index.
+		ldw y, (ASM_ARGS_SP_OFFSET+0, sp)
+		ld a, yh
+		xor a, (ASM_ARGS_SP_OFFSET+2, sp)
+		ld yh, a
+
+		.rept 2
+			; Take most-significant nibble of CRC and use as index into LUT.
+			; But, we want it as a byte offset into the LUT. Swap the nibbles,
+			; mask the low nibble, and multiply by 2.
+			swap a
+			and a, #0x0F
+			sll a
+			clrw x
+			ld xl, a
+
+			; Shift the CRC value left by 4 bits.
+			.rept 4
+				sllw y
+			.endm
+
+			; XOR each byte of the CRC with the corresponding byte of the
+			; value in the LUT, leaving the MSB in A for the next iteration.
+			ld a, yl
+			xor a, (CRC_LUT_RAM_SYM+1, x)
+			ld yl, a
+			ld a, yh
+			xor a, (CRC_LUT_RAM_SYM+0, x)
+			ld yh, a
+		.endm
+
+		; Move the CRC value to the X register for function return value.
+		ldw x, y
+
+		ASM_RETURN
+	__endasm;
+}
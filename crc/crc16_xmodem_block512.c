@@ -0,0 +1,145 @@
+/*******************************************************************************
+ *
+ * crc16_xmodem_block512.c - CRC16-XMODEM 512-byte block implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC16-XMODEM (as used by SD/MMC card data blocks)
+// Polynomial: x^16 + x^12 + x^5 + 1 (0x1021, normal)
+// Initial value: 0x0000
+// XOR out: 0x0000
+
+// Rather than shifting the CRC through each bit of the data byte, this uses
+// the byte-wise form of the CCITT polynomial, which needs no lookup table:
+//   x = (crc >> 8) ^ data
+//   x ^= x >> 4
+//   crc = (crc << 8) ^ (x << 12) ^ (x << 5) ^ x
+// Because the block length is fixed (and a multiple of 8), the loop may be
+// unrolled without any code to handle a remainder.
+
+uint16_t crc16_xmodem_block512(const void *data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)data;
+
+	// For return value: 0xAABB
+	// x = 0xAABB (xh = 0xAA, xl = 0xBB)
+
+	__asm
+		; Load data pointer from stack into X reg.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+
+		; Put the initial CRC value (zero) on the stack, followed by a byte of
+		; temporary storage. The CRC MSB is then at (2, sp) and LSB at (3, sp),
+		; and the temporary value at (1, sp).
+		clrw y
+		pushw y
+		push a
+
+	.macro crc16_xmodem_block512_byte off
+			; Compute x = (MSB of CRC) XOR (data byte), then x = x XOR (x >> 4),
+			; and save it.
+			ld a, (off, x)
+			xor a, (2, sp)
+			ld (1, sp), a
+			swap a
+			and a, #0x0F
+			xor a, (1, sp)
+			ld (1, sp), a
+
+			; New CRC MSB = (old CRC LSB) XOR (x << 4) XOR (x >> 3).
+			swap a
+			and a, #0xF0
+			xor a, (3, sp)
+			ld (2, sp), a
+			ld a, (1, sp)
+			srl a
+			srl a
+			srl a
+			xor a, (2, sp)
+			ld (2, sp), a
+
+			; New CRC LSB = (x << 5) XOR x.
+			ld a, (1, sp)
+			swap a
+			and a, #0xF0
+			sll a
+			xor a, (1, sp)
+			ld (3, sp), a
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		; Process 8 bytes per iteration of the loop.
+		ldw y, #(512 / 8)
+
+	0001$:
+
+		crc16_xmodem_block512_byte 0
+		crc16_xmodem_block512_byte 1
+		crc16_xmodem_block512_byte 2
+		crc16_xmodem_block512_byte 3
+		crc16_xmodem_block512_byte 4
+		crc16_xmodem_block512_byte 5
+		crc16_xmodem_block512_byte 6
+		crc16_xmodem_block512_byte 7
+
+		; Advance the data pointer past the 8 bytes, then decrement counter and
+		; loop around if it is not zero. The loop is too long for a relative
+		; jump back to its start.
+		addw x, #8
+		decw y
+		jreq 0002$
+		ASM_JUMP 0001$
+
+	0002$:
+
+#else
+
+		; Initialise counter to loop 512 times, once for each data byte.
+		ldw y, #512
+
+	0001$:
+
+		crc16_xmodem_block512_byte 0
+
+		; Advance the data pointer, then decrement counter and loop around if
+		; it is not zero.
+		incw x
+		decw y
+		jrne 0001$
+
+#endif
+
+		; Discard the temporary value and pop the CRC from the stack into the
+		; X reg for function return value.
+		pop a
+		popw x
+
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ * crc32_far.c - CRC32 far (24-bit address) buffer implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC32 (aka GZIP, PKZIP, PNG, ZMODEM)
+// Polynomial: x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x + 1 (0xEDB88320, reversed)
+// Initial value: 0xFFFFFFFF
+// XOR out: 0xFFFFFFFF
+
+uint32_t crc32_update_far(uint32_t addr, uint32_t len, uint32_t crc) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)addr;
+	(void)len;
+	(void)crc;
+
+	// For return value/arg: 0xAABBCCDD
+	// x = 0xCCDD (xh = 0xCC, xl = 0xDD)
+	// y = 0xAABB (yh = 0xAA, yl = 0xBB)
+
+	// For address/length args: 0x00EEFFGG
+	// 0xEE = extended (bank) byte, 0xFFGG = low word
+
+	__asm
+		; Load length from stack, and if it is zero, there is nothing to do, so
+		; load the unchanged CRC value from stack into X and Y regs for function
+		; return value and return straight away.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		jrne 0003$
+		ldw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		jrne 0003$
+		ldw x, (ASM_ARGS_SP_OFFSET+10, sp)
+		ldw y, (ASM_ARGS_SP_OFFSET+8, sp)
+		ASM_RETURN
+
+	0003$:
+		; Add the address to the length to give the 24-bit end address, and
+		; put it back on the stack in place of the length.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		addw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		ldw (ASM_ARGS_SP_OFFSET+6, sp), x
+		ld a, (ASM_ARGS_SP_OFFSET+5, sp)
+		adc a, (ASM_ARGS_SP_OFFSET+1, sp)
+		ld (ASM_ARGS_SP_OFFSET+5, sp), a
+
+		; Load CRC variable from stack into X & Y regs. The CRC is kept in
+		; registers for the duration of the loop, so the address is worked on
+		; from the stack.
+		ldw x, (ASM_ARGS_SP_OFFSET+10, sp)
+		ldw y, (ASM_ARGS_SP_OFFSET+8, sp)
+
+		; Save the LSW of the CRC on the stack while the X reg is used for the
+		; address. Note: this moves stack offset of args by 2 bytes.
+		pushw x
+
+	0001$:
+		; Load a byte from the address. The LDF instruction only takes a
+		; constant extended offset, so select the instruction to use according
+		; to the bank byte of the address. Addresses must be below 0x30000,
+		; which covers the flash of all STM8 devices.
+		ldw x, (ASM_ARGS_SP_OFFSET+2+2, sp)
+		ld a, (ASM_ARGS_SP_OFFSET+2+1, sp)
+		jrne 0004$
+		ld a, (x)
+		jra 0006$
+	0004$:
+		dec a
+		jrne 0005$
+		ldf a, (0x010000, x)
+		jra 0006$
+	0005$:
+		ldf a, (0x020000, x)
+	0006$:
+
+		; Advance the address, carrying into the bank byte when the low word
+		; wraps around past a 64KB boundary.
+		incw x
+		ldw (ASM_ARGS_SP_OFFSET+2+2, sp), x
+		jrne 0007$
+		inc (ASM_ARGS_SP_OFFSET+2+1, sp)
+	0007$:
+
+		; XOR the LSB of the CRC with data byte, then restore the LSW of the
+		; CRC to the X reg.
+		xor a, (2, sp)
+		ld (2, sp), a
+		popw x
+
+	.macro crc32_update_far_shift_xor skip_lbl
+			; Shift CRC value right by one bit.
+			srlw y
+			rrcw x
+
+			; Jump if least-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			rrwa x
+			xor a, #0x20
+			rrwa x
+			xor a, #0x83
+			rrwa x
+			rrwa y
+			xor a, #0xB8
+			rrwa y
+			xor a, #0xED
+			rrwa y
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc32_update_far_shift_xor 0011$
+		crc32_update_far_shift_xor 0012$
+		crc32_update_far_shift_xor 0013$
+		crc32_update_far_shift_xor 0014$
+		crc32_update_far_shift_xor 0015$
+		crc32_update_far_shift_xor 0016$
+		crc32_update_far_shift_xor 0017$
+		crc32_update_far_shift_xor 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0002$:
+
+		crc32_update_far_shift_xor 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0002$
+
+#endif
+
+		; Save the LSW of the CRC on the stack again, then loop around if the
+		; address has not yet reached the end address. The bank byte only
+		; needs comparing when the low words are equal.
+		pushw x
+		ldw x, (ASM_ARGS_SP_OFFSET+2+2, sp)
+		cpw x, (ASM_ARGS_SP_OFFSET+2+6, sp)
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+		jrne 0008$
+		ld a, (ASM_ARGS_SP_OFFSET+2+1, sp)
+		cp a, (ASM_ARGS_SP_OFFSET+2+5, sp)
+		jreq 0009$
+	0008$:
+		ASM_JUMP 0001$
+	0009$:
+#else
+		jrne 0001$
+		ld a, (ASM_ARGS_SP_OFFSET+2+1, sp)
+		cp a, (ASM_ARGS_SP_OFFSET+2+5, sp)
+		jrne 0001$
+#endif
+
+		; Restore the LSW of the CRC. The X and Y registers now contain updated
+		; CRC value, so leave them there as function return value.
+		popw x
+		ASM_RETURN
+	__endasm;
+}
@@ -36,7 +36,7 @@
 
 #ifdef ALGORITHM_LUT
 
-static const uint32_t crc32_posix_lut[16] = {
+static LUT_CONST uint32_t crc32_posix_lut[16] = {
 	0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9,
 	0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
 	0x2608EDB8, 0x22C9F00F, 0x2F8AD6D6, 0x2B4BCB61,
@@ -0,0 +1,162 @@
+/*******************************************************************************
+ *
+ * crc32_posix_memcpy.c - CRC32-POSIX fused copy and CRC implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC32-POSIX (aka cksum)
+// Polynomial: x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x + 1 (0x04C11DB7, normal)
+// Initial value: 0x00000000
+// XOR out: 0xFFFFFFFF
+
+uint32_t crc32_posix_memcpy(void *dst, const void *src, size_t len, uint32_t crc) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)dst;
+	(void)src;
+	(void)len;
+	(void)crc;
+
+	// For return value/arg: 0xAABBCCDD
+	// x = 0xCCDD (xh = 0xCC, xl = 0xDD)
+	// y = 0xAABB (yh = 0xAA, yl = 0xBB)
+
+	__asm
+		; Load length from stack, and if it is zero, there is nothing to do, so
+		; load the unchanged CRC value from stack into X and Y regs for function
+		; return value and return straight away.
+		ldw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		jrne 0003$
+		ldw x, (ASM_ARGS_SP_OFFSET+8, sp)
+		ldw y, (ASM_ARGS_SP_OFFSET+6, sp)
+		ASM_RETURN
+
+	0003$:
+		; Add the source pointer to the length to give the source end address,
+		; and put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		ldw (ASM_ARGS_SP_OFFSET+4, sp), x
+
+		; Load CRC variable from stack into X & Y regs. Unlike the CRC16
+		; version, the CRC is kept in registers for the duration of the loop,
+		; so the source and destination pointers are worked on from the stack.
+		ldw x, (ASM_ARGS_SP_OFFSET+8, sp)
+		ldw y, (ASM_ARGS_SP_OFFSET+6, sp)
+
+	0001$:
+		; Save the MSW of the CRC on the stack while the Y reg is used for the
+		; pointers. Note: this moves stack offset of args by 2 bytes.
+		pushw y
+
+		; Load a byte from the source, and advance the source pointer.
+		ldw y, (ASM_ARGS_SP_OFFSET+2+2, sp)
+		ld a, (y)
+		incw y
+		ldw (ASM_ARGS_SP_OFFSET+2+2, sp), y
+
+		; Store the byte to the destination, and advance the destination
+		; pointer. The data byte remains in the A register.
+		ldw y, (ASM_ARGS_SP_OFFSET+2+0, sp)
+		ld (y), a
+		incw y
+		ldw (ASM_ARGS_SP_OFFSET+2+0, sp), y
+
+		; XOR the MSB of the CRC with data byte, then restore the MSW of the
+		; CRC to the Y reg.
+		xor a, (1, sp)
+		ld (1, sp), a
+		popw y
+
+	.macro crc32_posix_memcpy_shift_xor skip_lbl
+			; Shift CRC value left by one bit.
+			sllw x
+			rlcw y
+
+			; Jump if most-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			rrwa x
+			xor a, #0xB7
+			rrwa x
+			xor a, #0x1D
+			rrwa x
+			rrwa y
+			xor a, #0xC1
+			rrwa y
+			xor a, #0x04
+			rrwa y
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc32_posix_memcpy_shift_xor 0011$
+		crc32_posix_memcpy_shift_xor 0012$
+		crc32_posix_memcpy_shift_xor 0013$
+		crc32_posix_memcpy_shift_xor 0014$
+		crc32_posix_memcpy_shift_xor 0015$
+		crc32_posix_memcpy_shift_xor 0016$
+		crc32_posix_memcpy_shift_xor 0017$
+		crc32_posix_memcpy_shift_xor 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0002$:
+
+		crc32_posix_memcpy_shift_xor 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0002$
+
+#endif
+
+		; Loop around if the source pointer has not yet reached the end address.
+		; The LSW of the CRC is temporarily saved on the stack so the X reg can
+		; be used for the comparison.
+		pushw x
+		ldw x, (ASM_ARGS_SP_OFFSET+2+2, sp)
+		cpw x, (ASM_ARGS_SP_OFFSET+2+4, sp)
+		popw x
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+		jreq 0004$
+		ASM_JUMP 0001$
+	0004$:
+#else
+		jrne 0001$
+#endif
+
+		; The X and Y registers now contain updated CRC value, so leave them
+		; there as function return value.
+		ASM_RETURN
+	__endasm;
+}
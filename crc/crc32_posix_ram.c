@@ -0,0 +1,99 @@
+/*******************************************************************************
+ *
+ * crc32_posix_ram.c - CRC32-POSIX RAM lookup table implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC32-POSIX (aka cksum)
+// Polynomial: x^32 + x^26 + x^23 + x^22 + x^16 + x^12 + x^11 + x^10 + x^8 + x^7 + x^5 + x^4 + x^2 + x + 1 (0x04C11DB7, normal)
+// Initial value: 0x00000000
+// XOR out: 0xFFFFFFFF
+//
+// Uses the lookup table built in RAM by crc_lut_ram_init(CRC_TYPE_CRC32_POSIX).
+
+uint32_t crc32_posix_update_ram(uint32_t crc, uint8_t data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)crc;
+	(void)data;
+
+	// For return value/arg: 0xAABBCCDD
+	// x = 0xCCDD (xh = 0xCC, xl = 0xDD)
+	// y = 0xAABB (yh = 0xAA, yl = 0xBB)
+
+	__asm
+		; XOR the MSB of the CRC with data byte and store back to CRC.
+		ld a, (ASM_ARGS_SP_OFFSET+4, sp)
+		xor a, (ASM_ARGS_SP_OFFSET+0, sp)
+		ld (ASM_ARGS_SP_OFFSET+0, sp), a
+
+		.rept 2
+			; Take most-significant nibble of CRC and use as index into LUT.
+			; But, we want it as a byte offset into the LUT. Swap the nibbles,
+			; mask the low nibble, and multiply by 4.
+			ld a, (ASM_ARGS_SP_OFFSET+0, sp)
+			swap a
+			and a, #0x0F
+			sll a
+			sll a
+
+			; LUT offset is in A, but we need it in X to perform the lookup.
+			clrw x
+			ld xl, a
+
+			; Shift the CRC value on the stack left by 4 bits.
+			.rept 4
+				sll (ASM_ARGS_SP_OFFSET+3, sp)
+				rlc (ASM_ARGS_SP_OFFSET+2, sp)
+				rlc (ASM_ARGS_SP_OFFSET+1, sp)
+				rlc (ASM_ARGS_SP_OFFSET+0, sp)
+			.endm
+
+			; For each byte of the CRC on stack, XOR it with the corresponding
+			; byte of the value in LUT (loaded from offset given in X), and
+			; store it back on the stack.
+			ld a, (CRC_LUT_RAM_SYM+0, x)
+			xor a, (ASM_ARGS_SP_OFFSET+0, sp)
+			ld (ASM_ARGS_SP_OFFSET+0, sp), a
+			ld a, (CRC_LUT_RAM_SYM+1, x)
+			xor a, (ASM_ARGS_SP_OFFSET+1, sp)
+			ld (ASM_ARGS_SP_OFFSET+1, sp), a
+			ld a, (CRC_LUT_RAM_SYM+2, x)
+			xor a, (ASM_ARGS_SP_OFFSET+2, sp)
+			ld (ASM_ARGS_SP_OFFSET+2, sp), a
+			ld a, (CRC_LUT_RAM_SYM+3, x)
+			xor a, (ASM_ARGS_SP_OFFSET+3, sp)
+			ld (ASM_ARGS_SP_OFFSET+3, sp), a
+		.endm
+
+		; Load CRC value from stack into X and Y regs for function return value.
+		ldw y, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw x, (ASM_ARGS_SP_OFFSET+2, sp)
+
+		ASM_RETURN
+	__endasm;
+}
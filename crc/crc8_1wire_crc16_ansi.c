@@ -0,0 +1,206 @@
+/*******************************************************************************
+ *
+ * crc8_1wire_crc16_ansi.c - CRC8-1WIRE and CRC16-ANSI dual implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC8-1WIRE (aka Dallas, Maxim, iButton)
+// Polynomial: x^8 + x^5 + x^4 + 1 (0x8C, reversed)
+// Initial value: 0x00
+// XOR out: 0x00
+
+// CRC16-ANSI (aka IBM, Modbus, USB)
+// Polynomial: x^16 + x^15 + x^2 + 1 (0xA001, reversed)
+// Initial value: 0xFFFF
+// XOR out: 0x0000
+
+void crc8_1wire_crc16_ansi_update_buf(const void *data, size_t len, uint8_t *crc8, uint16_t *crc16) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)data;
+	(void)len;
+	(void)crc8;
+	(void)crc16;
+
+	// For CRC16 value: 0xAABB
+	// x = 0xAABB (xh = 0xAA, xl = 0xBB)
+
+	__asm
+		; Load length from stack, and if it is zero, there is nothing to do, so
+		; return straight away.
+		ldw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		jrne 0003$
+		ASM_RETURN
+
+	0003$:
+		; Add the data pointer to the length to give the data end address, and
+		; put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw (ASM_ARGS_SP_OFFSET+2, sp), x
+
+		; Load the CRC8 value from where its pointer points, and put it on the
+		; stack as a local variable. Then do the same for the CRC16 value. Note:
+		; this moves stack offset of args by 3 bytes.
+		ldw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		ld a, (x)
+		push a
+		ldw x, (ASM_ARGS_SP_OFFSET+1+6, sp)
+		ldw x, (x)
+		pushw x
+
+	0001$:
+		; Load a byte from the data, and advance the data pointer. Keep a copy
+		; of the data byte in the YL reg, as both CRCs need it.
+		ldw x, (ASM_ARGS_SP_OFFSET+3+0, sp)
+		ld a, (x)
+		incw x
+		ldw (ASM_ARGS_SP_OFFSET+3+0, sp), x
+		ld yl, a
+
+		; XOR the LSB of the CRC16 with the data byte, and put it back. Then
+		; load the CRC16 into the X reg for further work.
+		xor a, (2, sp)
+		ld (2, sp), a
+		ldw x, (1, sp)
+
+	.macro crc8_1wire_crc16_ansi_update_buf_shift_xor_16 skip_lbl
+			; Shift CRC16 value right by one bit.
+			srlw x
+
+			; Jump if least-significant bit of CRC16 is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC16 value with the polynomial value.
+			rrwa x                       ; put LSB of crc into a
+			xor a, #0x01                 ; xor it with 0x01
+			rrwa x                       ; put MSB of crc into a
+			xor a, #0xA0                 ; xor it with 0xA0
+			rrwa x                       ; put counter back into a
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0011$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0012$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0013$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0014$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0015$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0016$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0017$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ld a, #8
+
+	0002$:
+
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_16 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		dec a
+		jrne 0002$
+
+#endif
+
+		; Put the updated CRC16 value back on the stack.
+		ldw (1, sp), x
+
+		; Load the CRC8 into the A reg and XOR it with the data byte.
+		ld a, yl
+		xor a, (3, sp)
+
+	.macro crc8_1wire_crc16_ansi_update_buf_shift_xor_8 skip_lbl
+			; Shift CRC8 value right by one bit.
+			srl a
+
+			; Jump if least-significant bit of CRC8 is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC8 value with the polynomial value.
+			xor a, #0x8C
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0021$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0022$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0023$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0024$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0025$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0026$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0027$
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0028$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ldw x, #8
+
+	0004$:
+
+		crc8_1wire_crc16_ansi_update_buf_shift_xor_8 0021$
+
+		; Decrement counter and loop around if it is not zero.
+		decw x
+		jrne 0004$
+
+#endif
+
+		; Put the updated CRC8 value back on the stack, then loop around if the
+		; data pointer has not yet reached the end address.
+		ld (3, sp), a
+		ldw x, (ASM_ARGS_SP_OFFSET+3+0, sp)
+		cpw x, (ASM_ARGS_SP_OFFSET+3+2, sp)
+#ifdef ALGORITHM_BITWISE_UNROLLED_LONG
+		jreq 0005$
+		ASM_JUMP 0001$
+	0005$:
+#else
+		jrne 0001$
+#endif
+
+		; Write the updated CRC8 and CRC16 values back to where their pointers
+		; point.
+		ldw x, (ASM_ARGS_SP_OFFSET+3+4, sp)
+		ld a, (3, sp)
+		ld (x), a
+		ldw x, (ASM_ARGS_SP_OFFSET+3+6, sp)
+		ldw y, (1, sp)
+		ldw (x), y
+
+		; Discard the local variables from the stack.
+		addw sp, #3
+
+		ASM_RETURN
+	__endasm;
+}
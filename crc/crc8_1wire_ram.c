@@ -0,0 +1,68 @@
+/*******************************************************************************
+ *
+ * crc8_1wire_ram.c - CRC8-1WIRE RAM lookup table implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC8-1WIRE (aka Dallas, Maxim, iButton)
+// Polynomial: x^8 + x^5 + x^4 + 1 (0x8C, reversed)
+// Initial value: 0x00
+// XOR out: 0x00
+//
+// Uses the lookup table built in RAM by crc_lut_ram_init(CRC_TYPE_CRC8_1WIRE).
+
+uint8_t crc8_1wire_update_ram(uint8_t crc, uint8_t data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)crc;
+	(void)data;
+
+	__asm
+		; Load CRC variable from stack into A register, and XOR it with the
+		; data byte.
+		ld a, (ASM_ARGS_SP_OFFSET+0, sp)
+		xor a, (ASM_ARGS_SP_OFFSET+1, sp)
+
+		.rept 2
+			; Put the least-significant nibble of the CRC in X as the index
+			; into the LUT, leaving the CRC in A.
+			clrw x
+			ld xl, a
+			and a, #0x0F
+			exg a, xl
+
+			; Shift the CRC right by 4 bits, then XOR it with the LUT value.
+			swap a
+			and a, #0x0F
+			xor a, (CRC_LUT_RAM_SYM, x)
+		.endm
+
+		; A register now contains updated CRC value, so leave it there as
+		; function return value.
+		ASM_RETURN
+	__endasm;
+}
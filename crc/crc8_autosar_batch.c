@@ -0,0 +1,139 @@
+/*******************************************************************************
+ *
+ * crc8_autosar_batch.c - CRC8-AUTOSAR batch implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC8-AUTOSAR (aka CRC8H2F)
+// Polynomial: x^8 + x^5 + x^3 + x^2 + 1 (0x2F, normal)
+// Initial value: 0xFF
+// XOR out: 0xFF
+
+void crc8_autosar_batch(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint8_t *out) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)base;
+	(void)stride;
+	(void)rec_len;
+	(void)count;
+	(void)out;
+
+	__asm
+		; Load record count from stack, and if it is zero, skip straight to the
+		; end.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		jreq 0005$
+
+	0001$:
+		; Add the record length to the record start address to give the record
+		; end address, and push it on the stack. Note: this moves stack offset
+		; of args by 2 bytes.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		addw x, (ASM_ARGS_SP_OFFSET+4, sp)
+		pushw x
+
+		; Load record start address into X, and the initial CRC value into A.
+		; If the record is empty, skip to finalising the CRC.
+		ldw x, (ASM_ARGS_SP_OFFSET+2+0, sp)
+		ld a, #0xFF
+		cpw x, (1, sp)
+		jreq 0004$
+
+	0002$:
+		; XOR the CRC with data byte.
+		xor a, (x)
+
+	.macro crc8_autosar_batch_shift_xor skip_lbl
+			; Shift CRC value left by one bit.
+			sll a
+
+			; Jump if most-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			xor a, #0x2F
+
+		skip_lbl:
+	.endm
+
+#ifdef ALGORITHM_BITWISE_UNROLLED
+
+		crc8_autosar_batch_shift_xor 0011$
+		crc8_autosar_batch_shift_xor 0012$
+		crc8_autosar_batch_shift_xor 0013$
+		crc8_autosar_batch_shift_xor 0014$
+		crc8_autosar_batch_shift_xor 0015$
+		crc8_autosar_batch_shift_xor 0016$
+		crc8_autosar_batch_shift_xor 0017$
+		crc8_autosar_batch_shift_xor 0018$
+
+#else
+
+		; Initialise counter to loop 8 times, once for each bit of data byte.
+		ldw y, #8
+
+	0003$:
+
+		crc8_autosar_batch_shift_xor 0011$
+
+		; Decrement counter and loop around if it is not zero.
+		decw y
+		jrne 0003$
+
+#endif
+
+		; Advance the data pointer, and loop around if it has not yet reached
+		; the record end address.
+		incw x
+		cpw x, (1, sp)
+		jrne 0002$
+
+	0004$:
+		; Finalise the CRC, discard the record end address from the stack, and
+		; store the CRC to the output array, advancing the output pointer.
+		xor a, #0xFF
+		popw x
+		ldw x, (ASM_ARGS_SP_OFFSET+8, sp)
+		ld (x), a
+		incw x
+		ldw (ASM_ARGS_SP_OFFSET+8, sp), x
+
+		; Advance the record start address by the stride.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		addw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		ldw (ASM_ARGS_SP_OFFSET+0, sp), x
+
+		; Decrement the record count, and loop around if it is not zero.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		decw x
+		ldw (ASM_ARGS_SP_OFFSET+6, sp), x
+		jrne 0001$
+
+	0005$:
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * crc8_j1850_bits.c - CRC8-J1850 bit-granular implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC8-SAE-J1850 (aka OBD)
+// Polynomial: x^8 + x^4 + x^3 + x^2 + 1 (0x1D, normal)
+// Initial value: 0xFF
+// XOR out: 0xFF
+
+uint8_t crc8_j1850_update_bits(uint8_t crc, uint8_t data, uint8_t nbits) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)crc;
+	(void)data;
+	(void)nbits;
+
+	__asm
+		; Load bit count from stack, and if it is zero, skip straight to the
+		; end.
+		ld a, (ASM_ARGS_SP_OFFSET+2, sp)
+		jreq 0003$
+
+		; Align the data bits to be used with the most-significant end of the
+		; byte, by shifting the data byte left by (8 - nbits) bits. Rather than
+		; shifting in a loop, test each bit of the shift count and do a shift
+		; of 1, 2 and 4 bits accordingly, so it takes near-constant time. Any
+		; unused bits are shifted out.
+		ld a, #8
+		sub a, (ASM_ARGS_SP_OFFSET+2, sp)
+		ld xl, a
+		ld a, (ASM_ARGS_SP_OFFSET+1, sp)
+		srlw x
+		jrnc 0004$
+		sll a
+	0004$:
+		srlw x
+		jrnc 0005$
+		sll a
+		sll a
+	0005$:
+		srlw x
+		jrnc 0006$
+		swap a
+		and a, #0xF0
+	0006$:
+
+		; XOR the CRC with the data bits. The A register now holds the CRC for
+		; further work.
+		xor a, (ASM_ARGS_SP_OFFSET+0, sp)
+
+	.macro crc8_j1850_update_bits_shift_xor skip_lbl
+			; Shift CRC value left by one bit.
+			sll a
+
+			; Jump if most-significant bit of CRC is now zero.
+			jrnc skip_lbl
+
+			; XOR the CRC value with the polynomial value.
+			xor a, #0x1D
+
+		skip_lbl:
+	.endm
+
+		; Loop once for each bit, using the bit count on the stack as the
+		; counter. Unrolling is not possible, as the number of bits varies.
+	0001$:
+
+		crc8_j1850_update_bits_shift_xor 0002$
+
+		; Decrement counter and loop around if it is not zero.
+		dec (ASM_ARGS_SP_OFFSET+2, sp)
+		jrne 0001$
+
+		; The A reg now contains updated CRC value, so leave it there as
+		; function return value.
+		ASM_RETURN
+
+	0003$:
+		; Nothing to do, so load the unchanged CRC value from stack into A reg
+		; for function return value.
+		ld a, (ASM_ARGS_SP_OFFSET+0, sp)
+
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * crc8_j1850_ram.c - CRC8-SAE-J1850 and CRC8-AUTOSAR RAM lookup table implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// CRC8-SAE-J1850 (aka OBD)
+// Polynomial: x^8 + x^4 + x^3 + x^2 + 1 (0x1D, normal)
+// Initial value: 0xFF
+// XOR out: 0xFF
+//
+// CRC8-AUTOSAR (aka CRC8H2F)
+// Polynomial: x^8 + x^5 + x^3 + x^2 + 1 (0x2F, normal)
+// Initial value: 0xFF
+// XOR out: 0xFF
+//
+// Both are non-reflected CRC8s, so differ only in the contents of the lookup
+// table built in RAM by crc_lut_ram_init(CRC_TYPE_CRC8_J1850) or
+// crc_lut_ram_init(CRC_TYPE_CRC8_AUTOSAR).
+
+uint8_t crc8_j1850_update_ram(uint8_t crc, uint8_t data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)crc;
+	(void)data;
+
+	__asm
+		; Load CRC variable from stack into A register, and XOR it with the
+		; data byte.
+		ld a, (ASM_ARGS_SP_OFFSET+0, sp)
+		xor a, (ASM_ARGS_SP_OFFSET+1, sp)
+
+		.rept 2
+			; Put the most-significant nibble of the CRC in X as the index
+			; into the LUT, leaving the CRC in A.
+			clrw x
+			ld xl, a
+			swap a
+			and a, #0x0F
+			exg a, xl
+
+			; Shift the CRC left by 4 bits, then XOR it with the LUT value.
+			swap a
+			and a, #0xF0
+			xor a, (CRC_LUT_RAM_SYM, x)
+		.endm
+
+		; A register now contains updated CRC value, so leave it there as
+		; function return value.
+		ASM_RETURN
+	__endasm;
+}
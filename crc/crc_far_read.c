@@ -0,0 +1,93 @@
+/*******************************************************************************
+ *
+ * crc_far_read.c - Far (24-bit address) memory read
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+void crc_far_read(void *dst, uint32_t addr, size_t len) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)dst;
+	(void)addr;
+	(void)len;
+
+	// For address arg: 0x00EEFFGG
+	// 0xEE = extended (bank) byte, 0xFFGG = low word
+
+	__asm
+		; Load length from stack, and if it is zero, skip straight to the end.
+		ldw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		jreq 0003$
+
+		; Add the destination pointer to the length to give the destination
+		; end address, and put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw (ASM_ARGS_SP_OFFSET+6, sp), x
+
+		; Load destination pointer into X and low word of address into Y.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw y, (ASM_ARGS_SP_OFFSET+4, sp)
+
+	0001$:
+		; Load a byte from the address. The LDF instruction only takes a
+		; constant extended offset, so select the instruction to use according
+		; to the bank byte of the address. Addresses must be below 0x30000,
+		; which covers the flash of all STM8 devices.
+		ld a, (ASM_ARGS_SP_OFFSET+3, sp)
+		jrne 0004$
+		ld a, (y)
+		jra 0006$
+	0004$:
+		dec a
+		jrne 0005$
+		ldf a, (0x010000, y)
+		jra 0006$
+	0005$:
+		ldf a, (0x020000, y)
+	0006$:
+
+		; Store the byte to the destination, and advance the destination
+		; pointer.
+		ld (x), a
+		incw x
+
+		; Advance the address, carrying into the bank byte when the low word
+		; wraps around past a 64KB boundary.
+		incw y
+		jrne 0002$
+		inc (ASM_ARGS_SP_OFFSET+3, sp)
+	0002$:
+
+		; Loop around if the destination pointer has not yet reached the end
+		; address.
+		cpw x, (ASM_ARGS_SP_OFFSET+6, sp)
+		jrne 0001$
+
+	0003$:
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,70 @@
+/*******************************************************************************
+ *
+ * crc_hash16.c - CRC16-based hashing of strings and buffers, and table lookup
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// Hash values are finalised CRC16-CCITT values, so that they are the same as
+// those computed by tools/hashgen.py.
+
+uint16_t crc_hash16_str(const char *str) {
+	uint16_t crc = crc16_ccitt_init();
+
+	while(*str != '\0') crc = crc16_ccitt_update(crc, (uint8_t)*str++);
+
+	return crc16_ccitt_final(crc);
+}
+
+uint16_t crc_hash16_buf(const void *data, const size_t len) {
+	const uint8_t *p = data;
+	uint16_t crc = crc16_ccitt_init();
+
+	for(size_t i = 0; i < len; i++) crc = crc16_ccitt_update(crc, p[i]);
+
+	return crc16_ccitt_final(crc);
+}
+
+uint8_t crc_hash16_lookup(const crc_hash16_table_t *table, const uint16_t hash) {
+	// The home slot of the hash is found by folding the hash to a byte and
+	// multiplying it by the seed chosen for the table by tools/hashgen.py, which
+	// spreads the similar hashes of similar keys (a CRC being linear) across
+	// the table. The probe then continues linearly, until either a slot with
+	// the same hash or an empty slot is found. The search is bounded in case
+	// the table has no empty slot.
+	uint8_t i = (uint8_t)(((uint16_t)((uint8_t)hash ^ (uint8_t)(hash >> 8)) * table->seed) >> 8);
+	uint8_t n = 0;
+
+	do {
+		i &= table->mask;
+		if(table->slots[i].value == CRC_HASH_EMPTY) break;
+		if(table->slots[i].hash == hash) return table->slots[i].value;
+		i++;
+	} while(n++ != table->mask);
+
+	return CRC_HASH_EMPTY;
+}
@@ -0,0 +1,65 @@
+/*******************************************************************************
+ *
+ * crc_hash8.c - CRC8-based hashing of strings and buffers, and table lookup
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// Hash values are finalised CRC8-AUTOSAR values, so that they are the same as
+// those computed by tools/hashgen.py.
+
+uint8_t crc_hash8_str(const char *str) {
+	uint8_t crc = crc8_autosar_init();
+
+	while(*str != '\0') crc = crc8_autosar_update(crc, (uint8_t)*str++);
+
+	return crc8_autosar_final(crc);
+}
+
+uint8_t crc_hash8_buf(const void *data, const size_t len) {
+	const uint8_t *p = data;
+	uint8_t crc = crc8_autosar_init();
+
+	for(size_t i = 0; i < len; i++) crc = crc8_autosar_update(crc, p[i]);
+
+	return crc8_autosar_final(crc);
+}
+
+uint8_t crc_hash8_lookup(const crc_hash8_table_t *table, const uint8_t hash) {
+	// As for crc_hash16_lookup(), except that the hash is already a byte.
+	uint8_t i = (uint8_t)(((uint16_t)hash * table->seed) >> 8);
+	uint8_t n = 0;
+
+	do {
+		i &= table->mask;
+		if(table->slots[i].value == CRC_HASH_EMPTY) break;
+		if(table->slots[i].hash == hash) return table->slots[i].value;
+		i++;
+	} while(n++ != table->mask);
+
+	return CRC_HASH_EMPTY;
+}
@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * crc_image.c - Firmware image verification against a CRC32 trailer
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// Layout of an image trailer in memory (all values big-endian):
+//
+//   crc_image_trailer_t  header
+//   uint32_t             block_crcs[header.block_count]
+//   uint32_t             trailer_crc
+//
+// The trailer CRC covers the header and block CRC table, so that a corrupt
+// trailer is never trusted. Trailers are produced by tools/image_stamp.py.
+
+static crc_image_result_t crc_image_verify_full(const uint32_t image_addr, const crc_image_trailer_t *trailer) {
+	uint32_t crc = crc32_update_far(image_addr, trailer->length, crc32_init());
+	return (crc32_final(crc) == trailer->crc ? CRC_IMAGE_OK : CRC_IMAGE_BAD_CRC);
+}
+
+static crc_image_result_t crc_image_verify_blocks(uint32_t image_addr, uint32_t table_addr, const crc_image_trailer_t *trailer) {
+	uint32_t remaining = trailer->length;
+	uint32_t crc, expected;
+	uint16_t len;
+
+	// Check each block against its entry in the table, giving up at the first
+	// that does not match. Only the last block may be shorter than the block
+	// size.
+	while(remaining > 0) {
+		len = (remaining < trailer->block_size ? (uint16_t)remaining : trailer->block_size);
+		crc = crc32_final(crc32_update_far(image_addr, len, crc32_init()));
+		crc_far_read(&expected, table_addr, sizeof(expected));
+		if(crc != expected) return CRC_IMAGE_BAD_CRC;
+		image_addr += len;
+		table_addr += sizeof(expected);
+		remaining -= len;
+	}
+
+	return CRC_IMAGE_OK;
+}
+
+crc_image_result_t crc_image_verify(const uint32_t image_addr, const uint32_t trailer_addr, const crc_image_verify_mode_t mode) {
+	crc_image_trailer_t trailer;
+	uint32_t table_addr = trailer_addr + sizeof(trailer);
+	uint32_t table_len, crc, expected;
+
+	crc_far_read(&trailer, trailer_addr, sizeof(trailer));
+
+	if(trailer.magic != CRC_IMAGE_MAGIC) return CRC_IMAGE_BAD_TRAILER;
+
+	// The block table, if present, must have exactly one entry per block.
+	if(trailer.block_size > 0) {
+		if(trailer.block_count != (uint16_t)((trailer.length + trailer.block_size - 1) / trailer.block_size)) {
+			return CRC_IMAGE_BAD_TRAILER;
+		}
+	} else if(trailer.block_count > 0) {
+		return CRC_IMAGE_BAD_TRAILER;
+	}
+
+	table_len = (uint32_t)trailer.block_count * sizeof(uint32_t);
+	crc = crc32_final(crc32_update_far(trailer_addr, sizeof(trailer) + table_len, crc32_init()));
+	crc_far_read(&expected, table_addr + table_len, sizeof(expected));
+	if(crc != expected) return CRC_IMAGE_BAD_TRAILER;
+
+	// Without a block table, only a full verification is possible.
+	if(mode == CRC_IMAGE_VERIFY_BLOCKS && trailer.block_count > 0) {
+		return crc_image_verify_blocks(image_addr, table_addr, &trailer);
+	} else {
+		return crc_image_verify_full(image_addr, &trailer);
+	}
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * crc_job.c - Resumable time-sliced CRC job implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// Initial and XOR-out values for each CRC type, indexed by crc_type_t.
+static const uint32_t crc_job_init_vals[] = {
+	CRC8_1WIRE_INIT,
+	CRC8_J1850_INIT,
+	CRC8_AUTOSAR_INIT,
+	CRC16_ANSI_INIT,
+	CRC16_CCITT_INIT,
+	CRC16_XMODEM_INIT,
+	CRC32_INIT,
+	CRC32_POSIX_INIT
+};
+
+static const uint32_t crc_job_xorout_vals[] = {
+	CRC8_1WIRE_XOROUT,
+	CRC8_J1850_XOROUT,
+	CRC8_AUTOSAR_XOROUT,
+	CRC16_ANSI_XOROUT,
+	CRC16_CCITT_XOROUT,
+	CRC16_XMODEM_XOROUT,
+	CRC32_XOROUT,
+	CRC32_POSIX_XOROUT
+};
+
+void crc_job_start(crc_job_t *job, const crc_type_t type, const void *data, const size_t len) {
+	job->type = type;
+	job->data = data;
+	job->remaining = len;
+	job->crc = crc_job_init_vals[type];
+}
+
+void crc_job_resume(crc_job_t *job, const void *data, const size_t len) {
+	// Continue the CRC (and keep the type) from where the job left off, with a
+	// new region of data, such as the next chunk read from external memory.
+	job->data = data;
+	job->remaining = len;
+}
+
+bool crc_job_step(crc_job_t *job, const size_t max_bytes) {
+	const uint8_t *data = job->data;
+	size_t n = (max_bytes < job->remaining ? max_bytes : job->remaining);
+
+	job->data += n;
+	job->remaining -= n;
+
+	// Each CRC width gets its own loop with a local variable of the natural
+	// size for the CRC value, so that only one switch is needed per slice
+	// rather than per byte.
+	switch(job->type) {
+		case CRC_TYPE_CRC8_1WIRE: {
+			uint8_t crc = (uint8_t)job->crc;
+			while(n--) crc = crc8_1wire_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+		case CRC_TYPE_CRC8_J1850: {
+			uint8_t crc = (uint8_t)job->crc;
+			while(n--) crc = crc8_j1850_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+		case CRC_TYPE_CRC8_AUTOSAR: {
+			uint8_t crc = (uint8_t)job->crc;
+			while(n--) crc = crc8_autosar_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+		case CRC_TYPE_CRC16_ANSI: {
+			uint16_t crc = (uint16_t)job->crc;
+			while(n--) crc = crc16_ansi_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+		case CRC_TYPE_CRC16_CCITT:
+		case CRC_TYPE_CRC16_XMODEM: {
+			uint16_t crc = (uint16_t)job->crc;
+			while(n--) crc = crc16_ccitt_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+		case CRC_TYPE_CRC32: {
+			uint32_t crc = job->crc;
+			while(n--) crc = crc32_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+		case CRC_TYPE_CRC32_POSIX: {
+			uint32_t crc = job->crc;
+			while(n--) crc = crc32_posix_update(crc, *data++);
+			job->crc = crc;
+			break;
+		}
+	}
+
+	return (job->remaining == 0);
+}
+
+uint32_t crc_job_result(const crc_job_t *job) {
+	return job->crc ^ crc_job_xorout_vals[job->type];
+}
@@ -0,0 +1,111 @@
+/*******************************************************************************
+ *
+ * crc_job_ckpt.c - Checkpointing of resumable CRC jobs
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// Type value of a checkpoint marking the end of a job (see
+// crc_job_ckpt_clear()). Rather than erasing the ring, which would restart it
+// at the first slot (wearing it faster than the others), the marker is saved
+// to the next slot like any other checkpoint.
+#define CRC_JOB_CKPT_TYPE_NONE 0xFF
+
+// Compute the check value of a checkpoint, being a CRC16-CCITT of all the
+// fields before it.
+static uint16_t crc_job_ckpt_check(const crc_job_ckpt_t *ckpt) {
+	const uint8_t *p = (const uint8_t *)ckpt;
+	uint16_t crc = crc16_ccitt_init();
+
+	for(size_t i = 0; i < offsetof(crc_job_ckpt_t, check); i++) {
+		crc = crc16_ccitt_update(crc, *p++);
+	}
+
+	return crc16_ccitt_final(crc);
+}
+
+// Find the slot with the newest valid checkpoint, returning its index, or
+// ring_len if no slot is valid. Sequence numbers are compared using serial
+// number arithmetic, so wrap-around of the 16-bit number is harmless.
+static uint8_t crc_job_ckpt_newest(const crc_job_ckpt_t *ring, const uint8_t ring_len) {
+	uint8_t newest = ring_len;
+
+	for(uint8_t i = 0; i < ring_len; i++) {
+		if(ring[i].check != crc_job_ckpt_check(&ring[i])) continue;
+		if(newest == ring_len || (int16_t)(ring[i].seq - ring[newest].seq) > 0) newest = i;
+	}
+
+	return newest;
+}
+
+static void crc_job_ckpt_write(crc_job_ckpt_t *ring, const uint8_t ring_len, const uint8_t type, const uint32_t offset, const uint32_t crc, crc_job_ckpt_write_func_t write_func) {
+	crc_job_ckpt_t ckpt;
+	uint8_t newest = crc_job_ckpt_newest(ring, ring_len);
+	uint8_t slot;
+
+	if(newest < ring_len) {
+		slot = (newest + 1 < ring_len ? newest + 1 : 0);
+		ckpt.seq = ring[newest].seq + 1;
+	} else {
+		slot = 0;
+		ckpt.seq = 0;
+	}
+
+	ckpt.offset = offset;
+	ckpt.crc = crc;
+	ckpt.type = type;
+	ckpt.check = crc_job_ckpt_check(&ckpt);
+
+	// The check value is written last (being the last field), so a slot only
+	// becomes valid once completely written. Should power fail part-way, the
+	// previous checkpoint, in another slot, remains the newest valid one.
+	write_func(&ring[slot], &ckpt, sizeof(ckpt));
+}
+
+void crc_job_ckpt_save(crc_job_ckpt_t *ring, const uint8_t ring_len, const crc_job_t *job, const uint32_t offset, crc_job_ckpt_write_func_t write_func) {
+	crc_job_ckpt_write(ring, ring_len, job->type, offset, job->crc, write_func);
+}
+
+bool crc_job_ckpt_load(const crc_job_ckpt_t *ring, const uint8_t ring_len, crc_job_t *job, uint32_t *offset) {
+	uint8_t newest = crc_job_ckpt_newest(ring, ring_len);
+
+	if(newest >= ring_len || ring[newest].type == CRC_JOB_CKPT_TYPE_NONE) return false;
+
+	// No data yet; the application continues the job from the offset with
+	// crc_job_resume().
+	job->type = (crc_type_t)ring[newest].type;
+	job->crc = ring[newest].crc;
+	job->data = NULL;
+	job->remaining = 0;
+	*offset = ring[newest].offset;
+
+	return true;
+}
+
+void crc_job_ckpt_clear(crc_job_ckpt_t *ring, const uint8_t ring_len, crc_job_ckpt_write_func_t write_func) {
+	crc_job_ckpt_write(ring, ring_len, CRC_JOB_CKPT_TYPE_NONE, 0, 0, write_func);
+}
@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * crc_lut_ram.c - RAM lookup table generation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+
+// The table is placed at a fixed address if one is given when building the
+// library. An address below 0x100 allows the lookup functions to use short
+// (8-bit) offset addressing. The application must ensure that nothing else is
+// allocated at that address.
+#ifdef CRC_LUT_RAM_ADDR
+__at(CRC_LUT_RAM_ADDR) uint8_t crc_lut_ram[CRC_LUT_RAM_SIZE];
+#else
+uint8_t crc_lut_ram[CRC_LUT_RAM_SIZE];
+#endif
+
+// Parameters for building the table for each CRC type, indexed by crc_type_t.
+// Reflected polynomials are given in reversed form.
+static const uint32_t crc_lut_ram_polys[] = {
+	0x8C,
+	0x1D,
+	0x2F,
+	0xA001,
+	0x1021,
+	0x1021,
+	0xEDB88320,
+	0x04C11DB7
+};
+
+static const uint8_t crc_lut_ram_widths[] = {
+	8, 8, 8, 16, 16, 16, 32, 32
+};
+
+static const bool crc_lut_ram_reflected[] = {
+	true, false, false, true, false, false, true, false
+};
+
+void crc_lut_ram_init(const crc_type_t type) {
+	const uint32_t poly = crc_lut_ram_polys[type];
+	const uint8_t width = crc_lut_ram_widths[type];
+	const uint32_t top_bit = (uint32_t)1 << (width - 1);
+	uint8_t *entry = crc_lut_ram;
+	uint32_t val;
+
+	// Each entry is the CRC (from zero) of one 4-bit nibble, stored as a
+	// big-endian value of the width of the CRC.
+	for(uint8_t i = 0; i < 16; i++) {
+		if(crc_lut_ram_reflected[type]) {
+			val = i;
+			for(uint8_t j = 0; j < 4; j++) {
+				val = (val & 1) ? ((val >> 1) ^ poly) : (val >> 1);
+			}
+		} else {
+			val = (uint32_t)i << (width - 4);
+			for(uint8_t j = 0; j < 4; j++) {
+				val = (val & top_bit) ? ((val << 1) ^ poly) : (val << 1);
+			}
+		}
+
+		for(uint8_t j = width; j > 0; j -= 8) {
+			*entry++ = (uint8_t)(val >> (j - 8));
+		}
+	}
+}
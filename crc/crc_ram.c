@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * crc_ram.c - Support for executing library functions from RAM
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "../crc.h"
+#include "common.h"
+
+#ifdef EXECUTE_FROM_RAM
+
+// The code in this file is compiled C, which is not position-independent, so
+// must always execute from flash. Revert to the default code segment that
+// common.h changed.
+#pragma codeseg CODE
+
+// The s_CRC_RAM and l_CRC_RAM symbols are defined by the linker, being the
+// start address and length of the CRC_RAM segment containing all the library
+// assembly code.
+
+static uint8_t *crc_ram_base = NULL;
+
+static uint16_t crc_ram_seg_start(void) __naked {
+	__asm
+		; Only the lower 16 bits of the address are needed, because they are
+		; used solely to calculate offsets within the segment.
+		ldw x, #s_CRC_RAM
+		ASM_RETURN
+	__endasm;
+}
+
+static void crc_ram_seg_copy(void *dst) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)dst;
+
+	__asm
+		; Load destination pointer into Y reg, and use X reg as index into
+		; segment, starting at zero.
+		ldw y, (ASM_ARGS_SP_OFFSET+0, sp)
+		clrw x
+		jra 0002$
+
+	0001$:
+		; Copy a byte from the segment to the destination. A far load is used
+		; so that the segment may be located anywhere in flash, including above
+		; 64K with the large memory model.
+		ldf a, (s_CRC_RAM, x)
+		ld (y), a
+		incw x
+		incw y
+
+	0002$:
+		; Loop around until index reaches length of segment.
+		cpw x, #l_CRC_RAM
+		jrne 0001$
+
+		ASM_RETURN
+	__endasm;
+}
+
+size_t crc_ram_size(void) __naked {
+	__asm
+		ldw x, #l_CRC_RAM
+		ASM_RETURN
+	__endasm;
+}
+
+bool crc_ram_init(void *buf, const size_t buf_len) {
+	if(buf_len < crc_ram_size()) return false;
+
+	crc_ram_seg_copy(buf);
+	crc_ram_base = buf;
+
+	return true;
+}
+
+uint16_t crc_ram_addr(const uint16_t func_addr) {
+	// Segment is always smaller than 64K, so the offset of the function within
+	// it can be calculated using only the lower 16 bits of the addresses, even
+	// if the segment straddles a 64K boundary.
+	return (uint16_t)crc_ram_base + (func_addr - crc_ram_seg_start());
+}
+
+#endif // EXECUTE_FROM_RAM
@@ -0,0 +1,72 @@
+/*******************************************************************************
+ *
+ * fletcher16.c - Fletcher-16 checksum implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// Fletcher-16
+// Modulus: 255
+// Initial value: 0x0000
+// XOR out: 0x0000
+
+uint16_t fletcher16_update(uint16_t sum, uint8_t data) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)sum;
+	(void)data;
+
+	// For return value/arg: 0xAABB
+	// x = 0xAABB (xh = 0xAA = sum2, xl = 0xBB = sum1)
+
+	__asm
+		; Add the data byte to the first sum (LSB). Taking the result modulo
+		; 255 is done by adding any carry back in (because 256 is congruent to
+		; 1), then making a result of 255 into zero.
+		ld a, (ASM_ARGS_SP_OFFSET+1, sp)
+		add a, (ASM_ARGS_SP_OFFSET+2, sp)
+		adc a, #0
+		cp a, #0xFF
+		jrne 0001$
+		clr a
+	0001$:
+		ld xl, a
+
+		; Add the new first sum to the second sum (MSB), modulo 255 the same
+		; way.
+		add a, (ASM_ARGS_SP_OFFSET+0, sp)
+		adc a, #0
+		cp a, #0xFF
+		jrne 0002$
+		clr a
+	0002$:
+		ld xh, a
+
+		; The X reg now contains updated checksum value, so leave it there as
+		; function return value.
+		ASM_RETURN
+	__endasm;
+}
@@ -0,0 +1,98 @@
+/*******************************************************************************
+ *
+ * fletcher16_buf.c - Fletcher-16 checksum buffer implementation
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "../crc.h"
+#include "common.h"
+
+// Fletcher-16
+// Modulus: 255
+// Initial value: 0x0000
+// XOR out: 0x0000
+
+uint16_t fletcher16_update_buf(const void *data, size_t len, uint16_t sum) __naked __stack_args {
+	// Avoid compiler warnings for unreferenced args.
+	(void)data;
+	(void)len;
+	(void)sum;
+
+	// For return value/arg: 0xAABB
+	// x = 0xAABB (xh = 0xAA = sum2, xl = 0xBB = sum1)
+
+	__asm
+		; Load length from stack, and if it is zero, skip straight to the end.
+		ldw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		jreq 0003$
+
+		; Add the data pointer to the length to give the data end address, and
+		; put it back on the stack in place of the length.
+		addw x, (ASM_ARGS_SP_OFFSET+0, sp)
+		ldw (ASM_ARGS_SP_OFFSET+2, sp), x
+
+		; Load data pointer into X.
+		ldw x, (ASM_ARGS_SP_OFFSET+0, sp)
+
+	0001$:
+		; Load a byte from the data, and advance the data pointer.
+		ld a, (x)
+		incw x
+
+		; Add the data byte to the first sum (LSB), then add the new first sum
+		; to the second sum (MSB). Taking each result modulo 255 is done by
+		; adding any carry back in (because 256 is congruent to 1). Unlike the
+		; update function, a result of 255 is left as-is until the end, as it
+		; is equivalent to zero and adds the same.
+		add a, (ASM_ARGS_SP_OFFSET+5, sp)
+		adc a, #0
+		ld (ASM_ARGS_SP_OFFSET+5, sp), a
+		add a, (ASM_ARGS_SP_OFFSET+4, sp)
+		adc a, #0
+		ld (ASM_ARGS_SP_OFFSET+4, sp), a
+
+		; Loop around if the data pointer has not yet reached the end address.
+		cpw x, (ASM_ARGS_SP_OFFSET+2, sp)
+		jrne 0001$
+
+		; Make any sum of 255 into zero.
+		ld a, (ASM_ARGS_SP_OFFSET+5, sp)
+		cp a, #0xFF
+		jrne 0002$
+		clr (ASM_ARGS_SP_OFFSET+5, sp)
+	0002$:
+		ld a, (ASM_ARGS_SP_OFFSET+4, sp)
+		cp a, #0xFF
+		jrne 0003$
+		clr (ASM_ARGS_SP_OFFSET+4, sp)
+
+	0003$:
+		; Load the checksum value from the stack into X reg for function return
+		; value.
+		ldw x, (ASM_ARGS_SP_OFFSET+4, sp)
+
+		ASM_RETURN
+	__endasm;
+}
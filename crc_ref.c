@@ -125,3 +125,39 @@ uint32_t crc32_posix_update_ref(uint32_t crc, uint8_t data) __stack_args {
 
 	return crc;
 }
+
+uint16_t fletcher16_update_ref(uint16_t sum, uint8_t data) __stack_args {
+	uint8_t sum1 = (uint8_t)sum;
+	uint8_t sum2 = (uint8_t)(sum >> 8);
+
+	sum1 = (uint8_t)(((uint16_t)sum1 + data) % 255);
+	sum2 = (uint8_t)(((uint16_t)sum2 + sum1) % 255);
+
+	return ((uint16_t)sum2 << 8) | sum1;
+}
+
+uint32_t adler32_update_ref(uint32_t sum, uint8_t data) __stack_args {
+	uint16_t a = (uint16_t)sum;
+	uint16_t b = (uint16_t)(sum >> 16);
+
+	a = (uint16_t)(((uint32_t)a + data) % 65521);
+	b = (uint16_t)(((uint32_t)b + a) % 65521);
+
+	return ((uint32_t)b << 16) | a;
+}
+
+uint8_t crc7_mmc_update_ref(uint8_t crc, uint8_t data) __stack_args {
+	// Unlike the library implementation, the CRC is kept in the lower 7 bits
+	// throughout, with each data bit (MSB first) combined with the top bit of
+	// the CRC.
+	for(uint8_t i = 0; i < 8; i++) {
+		if(((data >> 7) ^ (crc >> 6)) & 1) {
+			crc = ((crc << 1) ^ 0x09) & 0x7F;
+		} else {
+			crc = (crc << 1) & 0x7F;
+		}
+		data <<= 1;
+	}
+
+	return crc;
+}
@@ -49,5 +49,8 @@ extern uint16_t crc16_ansi_update_ref(uint16_t crc, uint8_t data) __stack_args;
 extern uint16_t crc16_ccitt_update_ref(uint16_t crc, uint8_t data) __stack_args;
 extern uint32_t crc32_update_ref(uint32_t crc, uint8_t data) __stack_args;
 extern uint32_t crc32_posix_update_ref(uint32_t crc, uint8_t data) __stack_args;
+extern uint16_t fletcher16_update_ref(uint16_t sum, uint8_t data) __stack_args;
+extern uint32_t adler32_update_ref(uint32_t sum, uint8_t data) __stack_args;
+extern uint8_t crc7_mmc_update_ref(uint8_t crc, uint8_t data) __stack_args;
 
 #endif // CRC_REF_H_
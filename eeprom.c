@@ -0,0 +1,54 @@
+/*******************************************************************************
+ *
+ * eeprom.c - Data EEPROM writing functions
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include "eeprom.h"
+#include "flash_regs.h"
+
+void eeprom_write(void *dst, const void *src, size_t len) {
+	volatile uint8_t *d = (volatile uint8_t *)dst;
+	const uint8_t *s = (const uint8_t *)src;
+
+	// Unlock the data EEPROM for writing.
+	FLASH_DUKR = FLASH_DUKR_KEY1;
+	FLASH_DUKR = FLASH_DUKR_KEY2;
+	while(!(FLASH_IAPSR & (1U << FLASH_IAPSR_DUL)));
+
+	while(len--) {
+		// Skip bytes that already have the required value, to save wear and
+		// the time taken by a write (approx. 6 ms per byte).
+		if(*d != *s) {
+			*d = *s;
+			while(!(FLASH_IAPSR & ((1U << FLASH_IAPSR_EOP) | (1U << FLASH_IAPSR_WR_PG_DIS))));
+		}
+		d++;
+		s++;
+	}
+
+	// Lock it again.
+	FLASH_IAPSR &= ~(1U << FLASH_IAPSR_DUL);
+}
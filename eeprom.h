@@ -0,0 +1,43 @@
+/*******************************************************************************
+ *
+ * eeprom.h - Data EEPROM writing functions
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Location and size of the data EEPROM of the STM8S208.
+#define EEPROM_START 0x4000
+#define EEPROM_SIZE 2048
+
+// Write a block of data to data EEPROM. The destination is given as the
+// address of the EEPROM location (which can be read directly, like RAM). Only
+// bytes that differ from the existing contents are written. Suitable for use
+// as the write function for crc_job_ckpt_save(), etc.
+extern void eeprom_write(void *dst, const void *src, size_t len);
+
+#endif // EEPROM_H_
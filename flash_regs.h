@@ -0,0 +1,21 @@
+#ifndef FLASH_REGS_H_
+#define FLASH_REGS_H_
+
+// Register definitions of STM8S208 for FLASH.
+
+#define FLASH_IAPSR (*(volatile uint8_t *)(0x505F))
+#define FLASH_IAPSR_WR_PG_DIS 0
+#define FLASH_IAPSR_PUL 1
+#define FLASH_IAPSR_EOP 2
+#define FLASH_IAPSR_DUL 3
+#define FLASH_IAPSR_HVOFF 6
+
+#define FLASH_PUKR (*(volatile uint8_t *)(0x5062))
+#define FLASH_PUKR_KEY1 0xAE
+#define FLASH_PUKR_KEY2 0x56
+
+#define FLASH_DUKR (*(volatile uint8_t *)(0x5064))
+#define FLASH_DUKR_KEY1 0xAE
+#define FLASH_DUKR_KEY2 0x56
+
+#endif // FLASH_REGS_H_
@@ -26,12 +26,30 @@
 
 #include <stddef.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdio.h>
+#include <string.h>
 #include "uart.h"
+#include "uart_regs.h"
+#include "tim2_regs.h"
+#include "print.h"
 #include "ucsim.h"
+#include "eeprom.h"
+#include "modbus_rtu.h"
+#include "xmodem.h"
+#define CRC_INLINE
 #include "crc.h"
 #include "crc_ref.h"
 
+// Library variants built with symbol suffixes (see CRC_VARIANT_SUFFIX in crc.h),
+// linked alongside the normal library, so that all algorithm options can be
+// verified and benchmarked in one run.
+#ifdef TEST_VARIANTS
+CRC_VARIANT_DECLARE(_small);
+CRC_VARIANT_DECLARE(_faster);
+CRC_VARIANT_DECLARE(_fastest);
+#endif
+
 #define CLK_CKDIVR (*(volatile uint8_t *)(0x50C6))
 
 // PC5 is connected to the built-in LED on the STM8S208 Nucleo-64 board.
@@ -43,10 +61,6 @@
 #define PC_CR1 (*(volatile uint8_t *)(0x500D))
 #define PC_CR1_C15 5
 
-typedef uint8_t (*crc8_update_func_t)(uint8_t crc, uint8_t data) __stack_args;
-typedef uint16_t (*crc16_update_func_t)(uint16_t crc, uint8_t data) __stack_args;
-typedef uint32_t (*crc32_update_func_t)(uint32_t crc, uint8_t data) __stack_args;
-
 typedef struct {
 	uint8_t init_val;
 	crc8_update_func_t update_func;
@@ -65,6 +79,21 @@ typedef struct {
 	uint32_t xorout_val;
 } crc32_type_t;
 
+typedef struct {
+	char *name;
+	crc8_type_t func;
+} crc8_bench_t;
+
+typedef struct {
+	char *name;
+	crc16_type_t func;
+} crc16_bench_t;
+
+typedef struct {
+	char *name;
+	crc32_type_t func;
+} crc32_bench_t;
+
 typedef struct {
 	char *name;
 	uint8_t *data;
@@ -92,30 +121,241 @@ typedef struct {
 	uint32_t expected;
 } crc32_test_t;
 
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	uint8_t init_val;
+	crc8_update_bits_func_t update_bits_func;
+	bool lsb_first;
+	uint8_t xorout_val;
+	uint8_t expected;
+} crc8_bits_test_t;
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	uint16_t init_val;
+	crc16_update_bits_func_t update_bits_func;
+	bool lsb_first;
+	uint16_t xorout_val;
+	uint16_t expected;
+} crc16_bits_test_t;
+
+typedef struct {
+	char *name;
+	crc_type_t type;
+	crc8_type_t func;
+	uint8_t expected;
+} crc8_ram_test_t;
+
+typedef struct {
+	char *name;
+	crc_type_t type;
+	crc16_type_t func;
+	uint16_t expected;
+} crc16_ram_test_t;
+
+typedef struct {
+	char *name;
+	crc_type_t type;
+	crc32_type_t func;
+	uint32_t expected;
+} crc32_ram_test_t;
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	uint16_t init_val;
+	crc16_memcpy_func_t memcpy_func;
+	uint16_t xorout_val;
+	uint16_t expected;
+} crc16_memcpy_test_t;
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	uint32_t init_val;
+	crc32_memcpy_func_t memcpy_func;
+	uint32_t xorout_val;
+	uint32_t expected;
+} crc32_memcpy_test_t;
+
+typedef void (*crc8_crc16_update_buf_func_t)(const void *data, size_t len, uint8_t *crc8, uint16_t *crc16) __stack_args;
+typedef void (*crc16_crc32_update_buf_func_t)(const void *data, size_t len, uint16_t *crc16, uint32_t *crc32) __stack_args;
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	uint8_t init_val_8;
+	uint16_t init_val_16;
+	crc8_crc16_update_buf_func_t update_buf_func;
+	uint8_t xorout_val_8;
+	uint16_t xorout_val_16;
+	uint8_t expected_8;
+	uint16_t expected_16;
+} crc8_crc16_update_buf_test_t;
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	uint16_t init_val_16;
+	uint32_t init_val_32;
+	crc16_crc32_update_buf_func_t update_buf_func;
+	uint16_t xorout_val_16;
+	uint32_t xorout_val_32;
+	uint16_t expected_16;
+	uint32_t expected_32;
+} crc16_crc32_update_buf_test_t;
+
+typedef void (*crc8_batch_func_t)(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint8_t *out) __stack_args;
+typedef void (*crc16_batch_func_t)(const uint8_t *base, size_t stride, size_t rec_len, size_t count, uint16_t *out) __stack_args;
+typedef uint16_t (*crc16_block512_func_t)(const void *data) __stack_args;
+typedef uint32_t (*crc32_far_func_t)(uint32_t addr, uint32_t len, uint32_t crc) __stack_args;
+typedef uint16_t (*fletcher16_update_buf_func_t)(const void *data, size_t len, uint16_t sum) __stack_args;
+typedef uint32_t (*adler32_update_buf_func_t)(const void *data, size_t len, uint32_t sum) __stack_args;
+
+typedef struct {
+	char *name;
+	crc8_batch_func_t batch_func;
+} crc8_batch_test_t;
+
+typedef struct {
+	char *name;
+	crc16_batch_func_t batch_func;
+} crc16_batch_test_t;
+
+typedef struct {
+	char *name;
+	crc16_block512_func_t block512_func;
+} crc16_block512_test_t;
+
+typedef struct {
+	char *name;
+	uint32_t init_val;
+	crc32_far_func_t update_far_func;
+	uint32_t xorout_val;
+	uint32_t expected;
+} crc32_far_test_t;
+
+typedef struct {
+	char *name;
+	fletcher16_update_buf_func_t update_buf_func;
+} fletcher16_buf_test_t;
+
+typedef struct {
+	char *name;
+	adler32_update_buf_func_t update_buf_func;
+} adler32_buf_test_t;
+
+typedef bool (*crc_check_func_t)(const uint8_t *frame, size_t len);
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	crc_check_func_t check_func;
+	bool expected;
+} crc_check_test_t;
+
+typedef struct {
+	char *name;
+	uint8_t *data;
+	size_t data_len;
+	crc_type_t type;
+	size_t slice_len;
+	uint32_t expected;
+} crc_job_test_t;
+
 #define benchmark_marker_start() do { PC_ODR |= (1 << PC_ODR_ODR5); } while(0)
 #define benchmark_marker_end() do { PC_ODR &= ~(1 << PC_ODR_ODR5); } while(0)
 
-static const crc8_type_t crc8_functions[] = {
-	{ CRC8_1WIRE_INIT, crc8_1wire_update_ref, CRC8_1WIRE_XOROUT },
-	{ CRC8_1WIRE_INIT, crc8_1wire_update, CRC8_1WIRE_XOROUT },
-	{ CRC8_J1850_INIT, crc8_j1850_update_ref, CRC8_J1850_XOROUT },
-	{ CRC8_J1850_INIT, crc8_j1850_update, CRC8_J1850_XOROUT },
-	{ CRC8_AUTOSAR_INIT, crc8_autosar_update_ref, CRC8_AUTOSAR_XOROUT },
-	{ CRC8_AUTOSAR_INIT, crc8_autosar_update, CRC8_AUTOSAR_XOROUT }
+// Null update functions, which do nothing but return the CRC unchanged. These
+// are benchmarked first for each CRC width, to measure the overhead of the
+// call and benchmark loop, so that it may be subtracted from the results of the
+// real functions to give the net time they take.
+static uint8_t crc8_update_null(uint8_t crc, uint8_t data) __stack_args {
+	(void)data;
+	return crc;
+}
+
+static uint16_t crc16_update_null(uint16_t crc, uint8_t data) __stack_args {
+	(void)data;
+	return crc;
+}
+
+static uint32_t crc32_update_null(uint32_t crc, uint8_t data) __stack_args {
+	(void)data;
+	return crc;
+}
+
+// Likewise, for the inline functions. The baseline is simply the overhead of
+// the benchmark loop.
+#define crc8_update_null_inline(crc, data) (crc)
+#define crc16_update_null_inline(crc, data) (crc)
+
+static const crc8_bench_t crc8_benchmarks[] = {
+	{ "null8", { 0, crc8_update_null, 0 } },
+	{ "crc8-1wire-c", { CRC8_1WIRE_INIT, crc8_1wire_update_ref, CRC8_1WIRE_XOROUT } },
+	{ "crc8-1wire-asm", { CRC8_1WIRE_INIT, crc8_1wire_update, CRC8_1WIRE_XOROUT } },
+	{ "crc8-j1850-c", { CRC8_J1850_INIT, crc8_j1850_update_ref, CRC8_J1850_XOROUT } },
+	{ "crc8-j1850-asm", { CRC8_J1850_INIT, crc8_j1850_update, CRC8_J1850_XOROUT } },
+	{ "crc8-autosar-c", { CRC8_AUTOSAR_INIT, crc8_autosar_update_ref, CRC8_AUTOSAR_XOROUT } },
+	{ "crc8-autosar-asm", { CRC8_AUTOSAR_INIT, crc8_autosar_update, CRC8_AUTOSAR_XOROUT } },
+	{ "crc7-mmc-c", { CRC7_MMC_INIT, crc7_mmc_update_ref, CRC7_MMC_XOROUT } },
+	{ "crc7-mmc-asm", { CRC7_MMC_INIT, crc7_mmc_update, CRC7_MMC_XOROUT } },
+#ifdef TEST_VARIANTS
+	{ "crc8-1wire-small", { CRC8_1WIRE_INIT, crc8_1wire_update_small, CRC8_1WIRE_XOROUT } },
+	{ "crc8-1wire-faster", { CRC8_1WIRE_INIT, crc8_1wire_update_faster, CRC8_1WIRE_XOROUT } },
+	{ "crc8-1wire-fastest", { CRC8_1WIRE_INIT, crc8_1wire_update_fastest, CRC8_1WIRE_XOROUT } },
+	{ "crc8-j1850-small", { CRC8_J1850_INIT, crc8_j1850_update_small, CRC8_J1850_XOROUT } },
+	{ "crc8-j1850-faster", { CRC8_J1850_INIT, crc8_j1850_update_faster, CRC8_J1850_XOROUT } },
+	{ "crc8-j1850-fastest", { CRC8_J1850_INIT, crc8_j1850_update_fastest, CRC8_J1850_XOROUT } },
+	{ "crc8-autosar-small", { CRC8_AUTOSAR_INIT, crc8_autosar_update_small, CRC8_AUTOSAR_XOROUT } },
+	{ "crc8-autosar-faster", { CRC8_AUTOSAR_INIT, crc8_autosar_update_faster, CRC8_AUTOSAR_XOROUT } },
+	{ "crc8-autosar-fastest", { CRC8_AUTOSAR_INIT, crc8_autosar_update_fastest, CRC8_AUTOSAR_XOROUT } }
+#endif
 };
 
-static const crc16_type_t crc16_functions[] = {
-	{ CRC16_ANSI_INIT, crc16_ansi_update_ref, CRC16_ANSI_XOROUT },
-	{ CRC16_ANSI_INIT, crc16_ansi_update, CRC16_ANSI_XOROUT },
-	{ CRC16_CCITT_INIT, crc16_ccitt_update_ref, CRC16_CCITT_XOROUT },
-	{ CRC16_CCITT_INIT, crc16_ccitt_update, CRC16_CCITT_XOROUT }
+static const crc16_bench_t crc16_benchmarks[] = {
+	{ "null16", { 0, crc16_update_null, 0 } },
+	{ "crc16-ansi-c", { CRC16_ANSI_INIT, crc16_ansi_update_ref, CRC16_ANSI_XOROUT } },
+	{ "crc16-ansi-asm", { CRC16_ANSI_INIT, crc16_ansi_update, CRC16_ANSI_XOROUT } },
+	{ "crc16-ccitt-c", { CRC16_CCITT_INIT, crc16_ccitt_update_ref, CRC16_CCITT_XOROUT } },
+	{ "crc16-ccitt-asm", { CRC16_CCITT_INIT, crc16_ccitt_update, CRC16_CCITT_XOROUT } },
+	{ "fletcher16-c", { FLETCHER16_INIT, fletcher16_update_ref, 0 } },
+	{ "fletcher16-asm", { FLETCHER16_INIT, fletcher16_update, 0 } },
+#ifdef TEST_VARIANTS
+	{ "crc16-ansi-small", { CRC16_ANSI_INIT, crc16_ansi_update_small, CRC16_ANSI_XOROUT } },
+	{ "crc16-ansi-faster", { CRC16_ANSI_INIT, crc16_ansi_update_faster, CRC16_ANSI_XOROUT } },
+	{ "crc16-ansi-fastest", { CRC16_ANSI_INIT, crc16_ansi_update_fastest, CRC16_ANSI_XOROUT } },
+	{ "crc16-ccitt-small", { CRC16_CCITT_INIT, crc16_ccitt_update_small, CRC16_CCITT_XOROUT } },
+	{ "crc16-ccitt-faster", { CRC16_CCITT_INIT, crc16_ccitt_update_faster, CRC16_CCITT_XOROUT } },
+	{ "crc16-ccitt-fastest", { CRC16_CCITT_INIT, crc16_ccitt_update_fastest, CRC16_CCITT_XOROUT } }
+#endif
 };
 
-static const crc32_type_t crc32_functions[] = {
-	{ CRC32_INIT, crc32_update_ref, CRC32_XOROUT },
-	{ CRC32_INIT, crc32_update, CRC32_XOROUT },
-	{ CRC32_POSIX_INIT, crc32_posix_update_ref, CRC32_POSIX_XOROUT },
-	{ CRC32_POSIX_INIT, crc32_posix_update, CRC32_POSIX_XOROUT }
+static const crc32_bench_t crc32_benchmarks[] = {
+	{ "null32", { 0, crc32_update_null, 0 } },
+	{ "crc32-c", { CRC32_INIT, crc32_update_ref, CRC32_XOROUT } },
+	{ "crc32-asm", { CRC32_INIT, crc32_update, CRC32_XOROUT } },
+	{ "crc32-posix-c", { CRC32_POSIX_INIT, crc32_posix_update_ref, CRC32_POSIX_XOROUT } },
+	{ "crc32-posix-asm", { CRC32_POSIX_INIT, crc32_posix_update, CRC32_POSIX_XOROUT } },
+	{ "adler32-c", { ADLER32_INIT, adler32_update_ref, 0 } },
+	{ "adler32-asm", { ADLER32_INIT, adler32_update, 0 } },
+#ifdef TEST_VARIANTS
+	{ "crc32-small", { CRC32_INIT, crc32_update_small, CRC32_XOROUT } },
+	{ "crc32-faster", { CRC32_INIT, crc32_update_faster, CRC32_XOROUT } },
+	{ "crc32-fastest", { CRC32_INIT, crc32_update_fastest, CRC32_XOROUT } },
+	{ "crc32-posix-small", { CRC32_POSIX_INIT, crc32_posix_update_small, CRC32_POSIX_XOROUT } },
+	{ "crc32-posix-faster", { CRC32_POSIX_INIT, crc32_posix_update_faster, CRC32_POSIX_XOROUT } },
+	{ "crc32-posix-fastest", { CRC32_POSIX_INIT, crc32_posix_update_fastest, CRC32_POSIX_XOROUT } }
+#endif
 };
 
 static const uint8_t test_data_a[] = {
@@ -154,6 +394,63 @@ static const uint8_t test_data_d[] = {
 	0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00
 };
 
+// SD card command CMD8 (SEND_IF_COND) with argument 0x1AA, as sent during
+// initialisation; the complete command ends with the byte 0x87, being the
+// CRC7 (0x43) shifted left with the end bit set.
+// From SD Physical Layer Simplified Specification, section 7.2.2
+static const uint8_t test_data_sd_cmd8[] = {
+	0x48, 0x00, 0x00, 0x01, 0xAA
+};
+
+// Frames for check tests, consisting of test data followed by its CRC, in
+// transmission order.
+static const uint8_t test_frame_crc8_1wire[] = {
+	0x02, 0x1C, 0xB8, 0x01, 0x00, 0x00, 0x00, 0xA2
+};
+
+static const uint8_t test_frame_crc8_j1850[] = {
+	0x33, 0x22, 0x55, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0xCB
+};
+
+static const uint8_t test_frame_crc8_autosar[] = {
+	0x33, 0x22, 0x55, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF, 0x11
+};
+
+static const uint8_t test_frame_crc16_ansi[] = {
+	0x01, 0x32, 0xF0, 0x21, 0x97, 0x68, 0x22, 0x3E, 0x0E, 0x2B
+};
+
+static const uint8_t test_frame_crc16_ccitt[] = {
+	0x01, 0x32, 0xF0, 0x21, 0x97, 0x68, 0x22, 0x3E, 0x6E, 0xBB
+};
+
+static const uint8_t test_frame_crc16_xmodem[] = {
+	0x01, 0x32, 0xF0, 0x21, 0x97, 0x68, 0x22, 0x3E, 0x5F, 0x85
+};
+
+static const uint8_t test_frame_crc32[] = {
+	0x01, 0x32, 0xF0, 0x21, 0x97, 0x68, 0x22, 0x3E, 0x2F, 0x6C, 0xC7, 0x7F
+};
+
+static const uint8_t test_frame_crc32_posix[] = {
+	0x01, 0x32, 0xF0, 0x21, 0x97, 0x68, 0x22, 0x3E, 0x93, 0xE5, 0xA4, 0x27
+};
+
+// Same as above, but with a single bit error in the data.
+static const uint8_t test_frame_crc32_bad[] = {
+	0x01, 0x32, 0xF0, 0x21, 0x97, 0x69, 0x22, 0x3E, 0x2F, 0x6C, 0xC7, 0x7F
+};
+
+// Stream of data containing a CRC16-ANSI frame (test_frame_crc16_ansi) at
+// offset 6, surrounded by junk, for rolling CRC tests.
+static const uint8_t test_stream_crc16_ansi[] = {
+	0xA7, 0x3C, 0x5D, 0x00, 0xFF, 0x12, 0x01, 0x32, 0xF0, 0x21, 0x97, 0x68, 0x22, 0x3E, 0x0E, 0x2B,
+	0x81, 0x44
+};
+
+// Rolling CRC table; too big to have on the stack.
+static crc16_ansi_rolling_t crc16_ansi_rolling;
+
 // All expected CRC values obtained from (and matching between) the following
 // calculators:
 // https://crccalc.com/
@@ -201,6 +498,30 @@ static const crc8_test_t crc8_tests[] = {
 		.c_func = { CRC8_AUTOSAR_INIT, crc8_autosar_update_ref, CRC8_AUTOSAR_XOROUT },
 		.asm_func = { CRC8_AUTOSAR_INIT, crc8_autosar_update, CRC8_AUTOSAR_XOROUT },
 		.expected = 0x11
+	},
+	{
+		.name = "crc7-mmc",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.c_func = { CRC7_MMC_INIT, crc7_mmc_update_ref, CRC7_MMC_XOROUT },
+		.asm_func = { CRC7_MMC_INIT, crc7_mmc_update, CRC7_MMC_XOROUT },
+		.expected = 0x30
+	},
+	{
+		.name = "crc7-mmc",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.c_func = { CRC7_MMC_INIT, crc7_mmc_update_ref, CRC7_MMC_XOROUT },
+		.asm_func = { CRC7_MMC_INIT, crc7_mmc_update, CRC7_MMC_XOROUT },
+		.expected = 0x4D
+	},
+	{
+		.name = "crc7-mmc",
+		.data = test_data_sd_cmd8,
+		.data_len = sizeof(test_data_sd_cmd8),
+		.c_func = { CRC7_MMC_INIT, crc7_mmc_update_ref, CRC7_MMC_XOROUT },
+		.asm_func = { CRC7_MMC_INIT, crc7_mmc_update, CRC7_MMC_XOROUT },
+		.expected = 0x43
 	}
 };
 
@@ -252,6 +573,22 @@ static const crc16_test_t crc16_tests[] = {
 		.c_func = { CRC16_XMODEM_INIT, crc16_xmodem_update_ref, CRC16_XMODEM_XOROUT },
 		.asm_func = { CRC16_XMODEM_INIT, crc16_xmodem_update, CRC16_XMODEM_XOROUT },
 		.expected = 0x2036
+	},
+	{
+		.name = "fletcher16",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.c_func = { FLETCHER16_INIT, fletcher16_update_ref, 0 },
+		.asm_func = { FLETCHER16_INIT, fletcher16_update, 0 },
+		.expected = 0xCCA5
+	},
+	{
+		.name = "fletcher16",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.c_func = { FLETCHER16_INIT, fletcher16_update_ref, 0 },
+		.asm_func = { FLETCHER16_INIT, fletcher16_update, 0 },
+		.expected = 0x4677
 	}
 };
 
@@ -287,134 +624,1964 @@ static const crc32_test_t crc32_tests[] = {
 		.c_func = { CRC32_POSIX_INIT, crc32_posix_update_ref, CRC32_POSIX_XOROUT },
 		.asm_func = { CRC32_POSIX_INIT, crc32_posix_update, CRC32_POSIX_XOROUT },
 		.expected = 0x4D84D9B6
+	},
+	{
+		.name = "adler32",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.c_func = { ADLER32_INIT, adler32_update_ref, 0 },
+		.asm_func = { ADLER32_INIT, adler32_update, 0 },
+		.expected = 0x0BC902A4
+	},
+	{
+		.name = "adler32",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.c_func = { ADLER32_INIT, adler32_update_ref, 0 },
+		.asm_func = { ADLER32_INIT, adler32_update, 0 },
+		.expected = 0xB7E879FE
 	}
 };
 
-/******************************************************************************/
-
-void print_hex(const void *data, const size_t data_len) {
-	for(size_t i = 0; i < data_len; i++) {
-		if(i > 0) putchar(' ');
-		printf("%02X", ((const uint8_t *)data)[i]);
-	}
-}
+#ifdef TEST_VARIANTS
 
-void verify(void) {
-	// Use ANSI terminal escape codes for highlighting pass/fail text.
-	static const char pass_str[] = "\x1B[1m\x1B[32mPASS\x1B[0m"; // Bold green
-	static const char fail_str[] = "\x1B[1m\x1B[31mFAIL\x1B[0m"; // Bold red
-	uint8_t crc_8_c, crc_8_asm;
-	uint16_t crc_16_c, crc_16_asm;
-	uint32_t crc_32_c, crc_32_asm;
+// Each library variant is tested with the 256-byte test data, giving the same
+// reference function and expected value for all three.
+#define variant_tests(name, type, func, expected) \
+	{ name "-small", test_data_b, sizeof(test_data_b), { type##_INIT, func##_ref, type##_XOROUT }, { type##_INIT, func##_small, type##_XOROUT }, expected }, \
+	{ name "-faster", test_data_b, sizeof(test_data_b), { type##_INIT, func##_ref, type##_XOROUT }, { type##_INIT, func##_faster, type##_XOROUT }, expected }, \
+	{ name "-fastest", test_data_b, sizeof(test_data_b), { type##_INIT, func##_ref, type##_XOROUT }, { type##_INIT, func##_fastest, type##_XOROUT }, expected }
 
-	printf("verify()\n");
+// As above, but for checksums, which have no final XOR.
+#define variant_sum_tests(name, type, func, expected) \
+	{ name "-small", test_data_b, sizeof(test_data_b), { type##_INIT, func##_ref, 0 }, { type##_INIT, func##_small, 0 }, expected }, \
+	{ name "-faster", test_data_b, sizeof(test_data_b), { type##_INIT, func##_ref, 0 }, { type##_INIT, func##_faster, 0 }, expected }, \
+	{ name "-fastest", test_data_b, sizeof(test_data_b), { type##_INIT, func##_ref, 0 }, { type##_INIT, func##_fastest, 0 }, expected }
 
-	for(size_t i = 0; i < (sizeof(crc8_tests) / sizeof(crc8_tests[0])); i++) {
-		printf("  %s:\n", crc8_tests[i].name);
-		printf("    data = ");
-		print_hex(crc8_tests[i].data, crc8_tests[i].data_len);
-		printf(" (%u bytes)\n", crc8_tests[i].data_len);
-		printf("    expected = 0x%02X\n", crc8_tests[i].expected);
+// Library variants of the other functions are added to the end of the tables
+// for them below, with the same test data and expected value as the entry for
+// the normal library function.
+#define variant_bits_tests(name, type, func, lsb_first, expected) \
+	{ name "-small", test_data_a, sizeof(test_data_a), type##_INIT, func##_small, lsb_first, type##_XOROUT, expected }, \
+	{ name "-faster", test_data_a, sizeof(test_data_a), type##_INIT, func##_faster, lsb_first, type##_XOROUT, expected }, \
+	{ name "-fastest", test_data_a, sizeof(test_data_a), type##_INIT, func##_fastest, lsb_first, type##_XOROUT, expected }
 
-		crc_8_c = crc8_tests[i].c_func.init_val;
-		crc_8_asm = crc8_tests[i].asm_func.init_val;
+#define variant_memcpy_tests(name, type, func, expected) \
+	{ name "-small", test_data_b, sizeof(test_data_b), type##_INIT, func##_small, type##_XOROUT, expected }, \
+	{ name "-faster", test_data_b, sizeof(test_data_b), type##_INIT, func##_faster, type##_XOROUT, expected }, \
+	{ name "-fastest", test_data_b, sizeof(test_data_b), type##_INIT, func##_fastest, type##_XOROUT, expected }
 
-		for(size_t n = 0; n < crc8_tests[i].data_len; n++) {
-			crc_8_c = (*crc8_tests[i].c_func.update_func)(crc_8_c, crc8_tests[i].data[n]);
-			crc_8_asm = (*crc8_tests[i].asm_func.update_func)(crc_8_asm, crc8_tests[i].data[n]);
-		}
+#define variant_update_buf_tests(name, type_a, type_b, func, expected_a, expected_b) \
+	{ name "-small", test_data_b, sizeof(test_data_b), type_a##_INIT, type_b##_INIT, func##_small, type_a##_XOROUT, type_b##_XOROUT, expected_a, expected_b }, \
+	{ name "-faster", test_data_b, sizeof(test_data_b), type_a##_INIT, type_b##_INIT, func##_faster, type_a##_XOROUT, type_b##_XOROUT, expected_a, expected_b }, \
+	{ name "-fastest", test_data_b, sizeof(test_data_b), type_a##_INIT, type_b##_INIT, func##_fastest, type_a##_XOROUT, type_b##_XOROUT, expected_a, expected_b }
 
-		crc_8_c ^= crc8_tests[i].c_func.xorout_val;
-		crc_8_asm ^= crc8_tests[i].asm_func.xorout_val;
+#define variant_far_tests(name, type, func, expected) \
+	{ name "-small", type##_INIT, func##_small, type##_XOROUT, expected }, \
+	{ name "-faster", type##_INIT, func##_faster, type##_XOROUT, expected }, \
+	{ name "-fastest", type##_INIT, func##_fastest, type##_XOROUT, expected }
 
-		printf("    c = 0x%02X - %s\n", crc_8_c, (crc_8_c == crc8_tests[i].expected ? pass_str : fail_str));
-		printf("    asm = 0x%02X - %s\n", crc_8_asm, (crc_8_asm == crc8_tests[i].expected ? pass_str : fail_str));
-	}
+#define variant_funcs(name, func) \
+	{ name "-small", func##_small }, \
+	{ name "-faster", func##_faster }, \
+	{ name "-fastest", func##_fastest }
 
-	for(size_t i = 0; i < (sizeof(crc16_tests) / sizeof(crc16_tests[0])); i++) {
-		printf("  %s:\n", crc16_tests[i].name);
-		printf("    data = ");
-		print_hex(crc16_tests[i].data, crc16_tests[i].data_len);
-		printf(" (%u bytes)\n", crc16_tests[i].data_len);
-		printf("    expected = 0x%04X\n", crc16_tests[i].expected);
+static const crc8_test_t crc8_variant_tests[] = {
+	variant_tests("crc8-1wire", CRC8_1WIRE, crc8_1wire_update, 0xE3),
+	variant_tests("crc8-j1850", CRC8_J1850, crc8_j1850_update, 0x28),
+	variant_tests("crc8-autosar", CRC8_AUTOSAR, crc8_autosar_update, 0xB3),
+	variant_tests("crc7-mmc", CRC7_MMC, crc7_mmc_update, 0x4D)
+};
 
-		crc_16_c = crc16_tests[i].c_func.init_val;
-		crc_16_asm = crc16_tests[i].asm_func.init_val;
+static const crc16_test_t crc16_variant_tests[] = {
+	variant_tests("crc16-ansi", CRC16_ANSI, crc16_ansi_update, 0x4173),
+	variant_tests("crc16-ccitt", CRC16_CCITT, crc16_ccitt_update, 0x61DE),
+	variant_sum_tests("fletcher16", FLETCHER16, fletcher16_update, 0x4677)
+};
 
-		for(size_t n = 0; n < crc16_tests[i].data_len; n++) {
-			crc_16_c = (*crc16_tests[i].c_func.update_func)(crc_16_c, crc16_tests[i].data[n]);
-			crc_16_asm = (*crc16_tests[i].asm_func.update_func)(crc_16_asm, crc16_tests[i].data[n]);
-		}
+static const crc32_test_t crc32_variant_tests[] = {
+	variant_tests("crc32", CRC32, crc32_update, 0x791FF31F),
+	variant_tests("crc32-posix", CRC32_POSIX, crc32_posix_update, 0x4D84D9B6),
+	variant_sum_tests("adler32", ADLER32, adler32_update, 0xB7E879FE)
+};
 
-		crc_16_c ^= crc16_tests[i].c_func.xorout_val;
-		crc_16_asm ^= crc16_tests[i].asm_func.xorout_val;
+#endif
 
-		printf("    c = 0x%04X - %s\n", crc_16_c, (crc_16_c == crc16_tests[i].expected ? pass_str : fail_str));
-		printf("    asm = 0x%04X - %s\n", crc_16_asm, (crc_16_asm == crc16_tests[i].expected ? pass_str : fail_str));
-	}
+static const crc8_bits_test_t crc8_bits_tests[] = {
+	{
+		.name = "crc8-1wire-bits",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.init_val = CRC8_1WIRE_INIT,
+		.update_bits_func = crc8_1wire_update_bits,
+		.lsb_first = true,
+		.xorout_val = CRC8_1WIRE_XOROUT,
+		.expected = 0x7C
+	},
+	{
+		.name = "crc8-j1850-bits",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.init_val = CRC8_J1850_INIT,
+		.update_bits_func = crc8_j1850_update_bits,
+		.lsb_first = false,
+		.xorout_val = CRC8_J1850_XOROUT,
+		.expected = 0x04
+	},
+	{
+		.name = "crc8-autosar-bits",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.init_val = CRC8_AUTOSAR_INIT,
+		.update_bits_func = crc8_autosar_update_bits,
+		.lsb_first = false,
+		.xorout_val = CRC8_AUTOSAR_XOROUT,
+		.expected = 0x92
+	},
+#ifdef TEST_VARIANTS
+	variant_bits_tests("crc8-1wire-bits", CRC8_1WIRE, crc8_1wire_update_bits, true, 0x7C),
+	variant_bits_tests("crc8-j1850-bits", CRC8_J1850, crc8_j1850_update_bits, false, 0x04),
+	variant_bits_tests("crc8-autosar-bits", CRC8_AUTOSAR, crc8_autosar_update_bits, false, 0x92)
+#endif
+};
 
-	for(size_t i = 0; i < (sizeof(crc32_tests) / sizeof(crc32_tests[0])); i++) {
-		printf("  %s:\n", crc32_tests[i].name);
-		printf("    data = ");
-		print_hex(crc32_tests[i].data, crc32_tests[i].data_len);
-		printf(" (%u bytes)\n", crc32_tests[i].data_len);
-		printf("    expected = 0x%08lX\n", crc32_tests[i].expected);
+static const crc16_bits_test_t crc16_bits_tests[] = {
+	{
+		.name = "crc16-ansi-bits",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.init_val = CRC16_ANSI_INIT,
+		.update_bits_func = crc16_ansi_update_bits,
+		.lsb_first = true,
+		.xorout_val = CRC16_ANSI_XOROUT,
+		.expected = 0x2B0E
+	},
+	{
+		.name = "crc16-ccitt-bits",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.init_val = CRC16_CCITT_INIT,
+		.update_bits_func = crc16_ccitt_update_bits,
+		.lsb_first = false,
+		.xorout_val = CRC16_CCITT_XOROUT,
+		.expected = 0x6EBB
+	},
+	{
+		.name = "crc16-xmodem-bits",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.init_val = CRC16_XMODEM_INIT,
+		.update_bits_func = crc16_xmodem_update_bits,
+		.lsb_first = false,
+		.xorout_val = CRC16_XMODEM_XOROUT,
+		.expected = 0x5F85
+	},
+#ifdef TEST_VARIANTS
+	variant_bits_tests("crc16-ansi-bits", CRC16_ANSI, crc16_ansi_update_bits, true, 0x2B0E),
+	variant_bits_tests("crc16-ccitt-bits", CRC16_CCITT, crc16_ccitt_update_bits, false, 0x6EBB)
+#endif
+};
 
-		crc_32_c = crc32_tests[i].c_func.init_val;
-		crc_32_asm = crc32_tests[i].asm_func.init_val;
+static const crc8_ram_test_t crc8_ram_tests[] = {
+	{ "crc8-1wire", CRC_TYPE_CRC8_1WIRE, { CRC8_1WIRE_INIT, crc8_1wire_update_ram, CRC8_1WIRE_XOROUT }, 0xE3 },
+	{ "crc8-j1850", CRC_TYPE_CRC8_J1850, { CRC8_J1850_INIT, crc8_j1850_update_ram, CRC8_J1850_XOROUT }, 0x28 },
+	{ "crc8-autosar", CRC_TYPE_CRC8_AUTOSAR, { CRC8_AUTOSAR_INIT, crc8_autosar_update_ram, CRC8_AUTOSAR_XOROUT }, 0xB3 }
+};
 
-		for(size_t n = 0; n < crc32_tests[i].data_len; n++) {
-			crc_32_c = (*crc32_tests[i].c_func.update_func)(crc_32_c, crc32_tests[i].data[n]);
-			crc_32_asm = (*crc32_tests[i].asm_func.update_func)(crc_32_asm, crc32_tests[i].data[n]);
-		}
+static const crc16_ram_test_t crc16_ram_tests[] = {
+	{ "crc16-ansi", CRC_TYPE_CRC16_ANSI, { CRC16_ANSI_INIT, crc16_ansi_update_ram, CRC16_ANSI_XOROUT }, 0x4173 },
+	{ "crc16-ccitt", CRC_TYPE_CRC16_CCITT, { CRC16_CCITT_INIT, crc16_ccitt_update_ram, CRC16_CCITT_XOROUT }, 0x61DE },
+	{ "crc16-xmodem", CRC_TYPE_CRC16_XMODEM, { CRC16_XMODEM_INIT, crc16_xmodem_update_ram, CRC16_XMODEM_XOROUT }, 0x2036 }
+};
 
-		crc_32_c ^= crc32_tests[i].c_func.xorout_val;
-		crc_32_asm ^= crc32_tests[i].asm_func.xorout_val;
+static const crc32_ram_test_t crc32_ram_tests[] = {
+	{ "crc32", CRC_TYPE_CRC32, { CRC32_INIT, crc32_update_ram, CRC32_XOROUT }, 0x791FF31F },
+	{ "crc32-posix", CRC_TYPE_CRC32_POSIX, { CRC32_POSIX_INIT, crc32_posix_update_ram, CRC32_POSIX_XOROUT }, 0x4D84D9B6 }
+};
 
-		printf("    c = 0x%08lX - %s\n", crc_32_c, (crc_32_c == crc32_tests[i].expected ? pass_str : fail_str));
-		printf("    asm = 0x%08lX - %s\n", crc_32_asm, (crc_32_asm == crc32_tests[i].expected ? pass_str : fail_str));
-	}
-}
+static const crc16_memcpy_test_t crc16_memcpy_tests[] = {
+	{
+		.name = "crc16-ansi-memcpy",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val = CRC16_ANSI_INIT,
+		.memcpy_func = crc16_ansi_memcpy,
+		.xorout_val = CRC16_ANSI_XOROUT,
+		.expected = 0x4173
+	},
+	{
+		.name = "crc16-ccitt-memcpy",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val = CRC16_CCITT_INIT,
+		.memcpy_func = crc16_ccitt_memcpy,
+		.xorout_val = CRC16_CCITT_XOROUT,
+		.expected = 0x61DE
+	},
+	{
+		.name = "crc16-xmodem-memcpy",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val = CRC16_XMODEM_INIT,
+		.memcpy_func = crc16_xmodem_memcpy,
+		.xorout_val = CRC16_XMODEM_XOROUT,
+		.expected = 0x2036
+	},
+#ifdef TEST_VARIANTS
+	variant_memcpy_tests("crc16-ansi-memcpy", CRC16_ANSI, crc16_ansi_memcpy, 0x4173),
+	variant_memcpy_tests("crc16-ccitt-memcpy", CRC16_CCITT, crc16_ccitt_memcpy, 0x61DE)
+#endif
+};
 
-void benchmark(const uint16_t iters) {
+static const crc32_memcpy_test_t crc32_memcpy_tests[] = {
+	{
+		.name = "crc32-memcpy",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val = CRC32_INIT,
+		.memcpy_func = crc32_memcpy,
+		.xorout_val = CRC32_XOROUT,
+		.expected = 0x791FF31F
+	},
+	{
+		.name = "crc32-posix-memcpy",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val = CRC32_POSIX_INIT,
+		.memcpy_func = crc32_posix_memcpy,
+		.xorout_val = CRC32_POSIX_XOROUT,
+		.expected = 0x4D84D9B6
+	},
+#ifdef TEST_VARIANTS
+	variant_memcpy_tests("crc32-memcpy", CRC32, crc32_memcpy, 0x791FF31F),
+	variant_memcpy_tests("crc32-posix-memcpy", CRC32_POSIX, crc32_posix_memcpy, 0x4D84D9B6)
+#endif
+};
+
+static const crc8_crc16_update_buf_test_t crc8_crc16_update_buf_tests[] = {
+	{
+		.name = "crc8-1wire-crc16-ansi-update-buf",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val_8 = CRC8_1WIRE_INIT,
+		.init_val_16 = CRC16_ANSI_INIT,
+		.update_buf_func = crc8_1wire_crc16_ansi_update_buf,
+		.xorout_val_8 = CRC8_1WIRE_XOROUT,
+		.xorout_val_16 = CRC16_ANSI_XOROUT,
+		.expected_8 = 0xE3,
+		.expected_16 = 0x4173
+	},
+#ifdef TEST_VARIANTS
+	variant_update_buf_tests("crc8-1wire-crc16-ansi-update-buf", CRC8_1WIRE, CRC16_ANSI, crc8_1wire_crc16_ansi_update_buf, 0xE3, 0x4173)
+#endif
+};
+
+static const crc16_crc32_update_buf_test_t crc16_crc32_update_buf_tests[] = {
+	{
+		.name = "crc16-ccitt-crc32-update-buf",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val_16 = CRC16_CCITT_INIT,
+		.init_val_32 = CRC32_INIT,
+		.update_buf_func = crc16_ccitt_crc32_update_buf,
+		.xorout_val_16 = CRC16_CCITT_XOROUT,
+		.xorout_val_32 = CRC32_XOROUT,
+		.expected_16 = 0x61DE,
+		.expected_32 = 0x791FF31F
+	},
+	{
+		.name = "crc16-xmodem-crc32-update-buf",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.init_val_16 = CRC16_XMODEM_INIT,
+		.init_val_32 = CRC32_INIT,
+		.update_buf_func = crc16_xmodem_crc32_update_buf,
+		.xorout_val_16 = CRC16_XMODEM_XOROUT,
+		.xorout_val_32 = CRC32_XOROUT,
+		.expected_16 = 0x2036,
+		.expected_32 = 0x791FF31F
+	},
+#ifdef TEST_VARIANTS
+	variant_update_buf_tests("crc16-ccitt-crc32-update-buf", CRC16_CCITT, CRC32, crc16_ccitt_crc32_update_buf, 0x61DE, 0x791FF31F)
+#endif
+};
+
+static const crc8_batch_test_t crc8_batch_tests[] = {
+	{ "crc8-autosar-batch", crc8_autosar_batch },
+#ifdef TEST_VARIANTS
+	variant_funcs("crc8-autosar-batch", crc8_autosar_batch)
+#endif
+};
+
+static const crc16_batch_test_t crc16_batch_tests[] = {
+	{ "crc16-ccitt-batch", crc16_ccitt_batch },
+#ifdef TEST_VARIANTS
+	variant_funcs("crc16-ccitt-batch", crc16_ccitt_batch)
+#endif
+};
+
+static const crc16_block512_test_t crc16_block512_tests[] = {
+	{ "crc16-xmodem-block512", crc16_xmodem_block512 },
+#ifdef TEST_VARIANTS
+	variant_funcs("crc16-xmodem-block512", crc16_xmodem_block512)
+#endif
+};
+
+static const crc32_far_test_t crc32_far_tests[] = {
+	{ "crc32-far", CRC32_INIT, crc32_update_far, CRC32_XOROUT, 0x791FF31F },
+	{ "crc32-posix-far", CRC32_POSIX_INIT, crc32_posix_update_far, CRC32_POSIX_XOROUT, 0x4D84D9B6 },
+#ifdef TEST_VARIANTS
+	variant_far_tests("crc32-far", CRC32, crc32_update_far, 0x791FF31F),
+	variant_far_tests("crc32-posix-far", CRC32_POSIX, crc32_posix_update_far, 0x4D84D9B6)
+#endif
+};
+
+static const fletcher16_buf_test_t fletcher16_buf_tests[] = {
+	{ "fletcher16-buf", fletcher16_update_buf },
+#ifdef TEST_VARIANTS
+	variant_funcs("fletcher16-buf", fletcher16_update_buf)
+#endif
+};
+
+static const adler32_buf_test_t adler32_buf_tests[] = {
+	{ "adler32-buf", adler32_update_buf },
+#ifdef TEST_VARIANTS
+	variant_funcs("adler32-buf", adler32_update_buf)
+#endif
+};
+
+static const crc_check_test_t crc_check_tests[] = {
+	{
+		.name = "crc8-1wire-check",
+		.data = test_frame_crc8_1wire,
+		.data_len = sizeof(test_frame_crc8_1wire),
+		.check_func = crc8_1wire_check,
+		.expected = true
+	},
+	{
+		.name = "crc8-j1850-check",
+		.data = test_frame_crc8_j1850,
+		.data_len = sizeof(test_frame_crc8_j1850),
+		.check_func = crc8_j1850_check,
+		.expected = true
+	},
+	{
+		.name = "crc8-autosar-check",
+		.data = test_frame_crc8_autosar,
+		.data_len = sizeof(test_frame_crc8_autosar),
+		.check_func = crc8_autosar_check,
+		.expected = true
+	},
+	{
+		.name = "crc16-ansi-check",
+		.data = test_frame_crc16_ansi,
+		.data_len = sizeof(test_frame_crc16_ansi),
+		.check_func = crc16_ansi_check,
+		.expected = true
+	},
+	{
+		.name = "crc16-ccitt-check",
+		.data = test_frame_crc16_ccitt,
+		.data_len = sizeof(test_frame_crc16_ccitt),
+		.check_func = crc16_ccitt_check,
+		.expected = true
+	},
+	{
+		.name = "crc16-xmodem-check",
+		.data = test_frame_crc16_xmodem,
+		.data_len = sizeof(test_frame_crc16_xmodem),
+		.check_func = crc16_xmodem_check,
+		.expected = true
+	},
+	{
+		.name = "crc32-check",
+		.data = test_frame_crc32,
+		.data_len = sizeof(test_frame_crc32),
+		.check_func = crc32_check,
+		.expected = true
+	},
+	{
+		.name = "crc32-posix-check",
+		.data = test_frame_crc32_posix,
+		.data_len = sizeof(test_frame_crc32_posix),
+		.check_func = crc32_posix_check,
+		.expected = true
+	},
+	{
+		.name = "crc32-check",
+		.data = test_frame_crc32_bad,
+		.data_len = sizeof(test_frame_crc32_bad),
+		.check_func = crc32_check,
+		.expected = false
+	}
+};
+
+static const crc_job_test_t crc_job_tests[] = {
+	{
+		.name = "crc8-1wire-job",
+		.data = test_data_d,
+		.data_len = sizeof(test_data_d),
+		.type = CRC_TYPE_CRC8_1WIRE,
+		.slice_len = 3,
+		.expected = 0xA2
+	},
+	{
+		.name = "crc16-ansi-job",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.type = CRC_TYPE_CRC16_ANSI,
+		.slice_len = 64,
+		.expected = 0x4173
+	},
+	{
+		.name = "crc16-xmodem-job",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.type = CRC_TYPE_CRC16_XMODEM,
+		.slice_len = 100,
+		.expected = 0x2036
+	},
+	{
+		.name = "crc32-job",
+		.data = test_data_b,
+		.data_len = sizeof(test_data_b),
+		.type = CRC_TYPE_CRC32,
+		.slice_len = 1,
+		.expected = 0x791FF31F
+	},
+	{
+		.name = "crc32-posix-job",
+		.data = test_data_a,
+		.data_len = sizeof(test_data_a),
+		.type = CRC_TYPE_CRC32_POSIX,
+		.slice_len = 5,
+		.expected = 0x93E5A427
+	}
+};
+
+// Destination buffer for memcpy tests; must be at least as big as largest test
+// data.
+static uint8_t memcpy_buf[sizeof(test_data_b)];
+
+// Batch tests and benchmarks divide test_data_b into 20-byte records at a
+// 24-byte stride, like an array of structs each with some trailing fields.
+#define BATCH_TEST_STRIDE 24
+#define BATCH_TEST_REC_LEN 20
+#define BATCH_TEST_COUNT (sizeof(test_data_b) / BATCH_TEST_STRIDE)
+
+// Buffer for 512-byte block tests and benchmarks, holding two copies of
+// test_data_b.
+static uint8_t block512_buf[512];
+
+// Command names for hash tests and benchmarks, with the hash tables for them
+// generated by:
+//   python3 tools/hashgen.py --prefix CMD get set list dump load save erase write read info reboot ping
+//   python3 tools/hashgen.py --bits 8 --prefix ID8 get set list dump load save erase write
+// The 8-bit table has fewer names because "info" and "ping" have the same
+// 8-bit hash.
+static const char * const hash_test_names[] = {
+	"get", "set", "list", "dump", "load", "save", "erase", "write", "read", "info", "reboot", "ping"
+};
+
+#define HASH_TEST_COUNT (sizeof(hash_test_names) / sizeof(hash_test_names[0]))
+#define HASH_TEST_COUNT_8 8
+
+// 12 keys, 16 slots, seed 80, at most 1 probe.
+
+#define CMD_HASH_GET 0x18AB
+#define CMD_HASH_SET 0x8708
+#define CMD_HASH_LIST 0xF4C3
+#define CMD_HASH_DUMP 0x27FA
+#define CMD_HASH_LOAD 0x3143
+#define CMD_HASH_SAVE 0x6FCE
+#define CMD_HASH_ERASE 0x49C8
+#define CMD_HASH_WRITE 0x3927
+#define CMD_HASH_READ 0x4F7F
+#define CMD_HASH_INFO 0x92CA
+#define CMD_HASH_REBOOT 0xDCA0
+#define CMD_HASH_PING 0xF72B
+
+#define CMD_INDEX_GET 0
+#define CMD_INDEX_SET 1
+#define CMD_INDEX_LIST 2
+#define CMD_INDEX_DUMP 3
+#define CMD_INDEX_LOAD 4
+#define CMD_INDEX_SAVE 5
+#define CMD_INDEX_ERASE 6
+#define CMD_INDEX_WRITE 7
+#define CMD_INDEX_READ 8
+#define CMD_INDEX_INFO 9
+#define CMD_INDEX_REBOOT 10
+#define CMD_INDEX_PING 11
+
+static const crc_hash16_slot_t cmd_hash_slots[16] = {
+	{ 0x0000, CRC_HASH_EMPTY },
+	{ CMD_HASH_LIST, CMD_INDEX_LIST },
+	{ CMD_HASH_SAVE, CMD_INDEX_SAVE },
+	{ CMD_HASH_LOAD, CMD_INDEX_LOAD },
+	{ CMD_HASH_PING, CMD_INDEX_PING },
+	{ CMD_HASH_DUMP, CMD_INDEX_DUMP },
+	{ CMD_HASH_REBOOT, CMD_INDEX_REBOOT },
+	{ CMD_HASH_GET, CMD_INDEX_GET },
+	{ CMD_HASH_ERASE, CMD_INDEX_ERASE },
+	{ CMD_HASH_WRITE, CMD_INDEX_WRITE },
+	{ 0x0000, CRC_HASH_EMPTY },
+	{ CMD_HASH_INFO, CMD_INDEX_INFO },
+	{ CMD_HASH_SET, CMD_INDEX_SET },
+	{ 0x0000, CRC_HASH_EMPTY },
+	{ 0x0000, CRC_HASH_EMPTY },
+	{ CMD_HASH_READ, CMD_INDEX_READ }
+};
+
+static const crc_hash16_table_t cmd_hash_table = { cmd_hash_slots, 0x0F, 80 };
+
+// 8 keys, 16 slots, seed 51, at most 1 probe.
+
+#define ID8_HASH_GET 0xC7
+#define ID8_HASH_SET 0x1F
+#define ID8_HASH_LIST 0xB0
+#define ID8_HASH_DUMP 0x17
+#define ID8_HASH_LOAD 0xE2
+#define ID8_HASH_SAVE 0x4A
+#define ID8_HASH_ERASE 0x53
+#define ID8_HASH_WRITE 0x4E
+
+#define ID8_INDEX_GET 0
+#define ID8_INDEX_SET 1
+#define ID8_INDEX_LIST 2
+#define ID8_INDEX_DUMP 3
+#define ID8_INDEX_LOAD 4
+#define ID8_INDEX_SAVE 5
+#define ID8_INDEX_ERASE 6
+#define ID8_INDEX_WRITE 7
+
+static const crc_hash8_slot_t id8_hash_slots[16] = {
+	{ ID8_HASH_ERASE, ID8_INDEX_ERASE },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ ID8_HASH_LIST, ID8_INDEX_LIST },
+	{ ID8_HASH_DUMP, ID8_INDEX_DUMP },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ ID8_HASH_SET, ID8_INDEX_SET },
+	{ ID8_HASH_GET, ID8_INDEX_GET },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ 0x00, CRC_HASH_EMPTY },
+	{ ID8_HASH_LOAD, ID8_INDEX_LOAD },
+	{ ID8_HASH_SAVE, ID8_INDEX_SAVE },
+	{ ID8_HASH_WRITE, ID8_INDEX_WRITE }
+};
+
+static const crc_hash8_table_t id8_hash_table = { id8_hash_slots, 0x0F, 51 };
+
+/******************************************************************************/
+
+// Buffer for image verification tests, holding a trailer for test_data_b, with
+// a block size of 64 bytes (giving 4 blocks).
+#define IMAGE_TEST_BLOCK_SIZE 64
+#define IMAGE_TEST_BLOCK_COUNT ((sizeof(test_data_b) + IMAGE_TEST_BLOCK_SIZE - 1) / IMAGE_TEST_BLOCK_SIZE)
+static uint8_t image_trailer_buf[sizeof(crc_image_trailer_t) + (IMAGE_TEST_BLOCK_COUNT * sizeof(uint32_t)) + sizeof(uint32_t)];
+
+// Compute a CRC32 of a buffer the simple way, independently of the library
+// buffer functions.
+static uint32_t crc32_buf(const uint8_t *data, size_t len) {
+	uint32_t crc = crc32_init();
+	while(len--) crc = crc32_update(crc, *data++);
+	return crc32_final(crc);
+}
+
+// Construct an image trailer in RAM the same way as tools/image_stamp.py would
+// stamp it into flash.
+static void image_trailer_build(void) {
+	crc_image_trailer_t *trailer = (crc_image_trailer_t *)image_trailer_buf;
+	uint32_t *table = (uint32_t *)(image_trailer_buf + sizeof(crc_image_trailer_t));
+
+	trailer->magic = CRC_IMAGE_MAGIC;
+	trailer->length = sizeof(test_data_b);
+	trailer->crc = crc32_buf(test_data_b, sizeof(test_data_b));
+	trailer->block_size = IMAGE_TEST_BLOCK_SIZE;
+	trailer->block_count = IMAGE_TEST_BLOCK_COUNT;
+	for(size_t i = 0; i < IMAGE_TEST_BLOCK_COUNT; i++) {
+		table[i] = crc32_buf(test_data_b + (i * IMAGE_TEST_BLOCK_SIZE), IMAGE_TEST_BLOCK_SIZE);
+	}
+	table[IMAGE_TEST_BLOCK_COUNT] = crc32_buf(image_trailer_buf, sizeof(image_trailer_buf) - sizeof(uint32_t));
+}
+
+// The first checkpoint test uses a ring in RAM, rather than data EEPROM, so
+// that a write interrupted by a power failure can be simulated by only writing
+// the first half of the checkpoint.
+#define CKPT_TEST_RING_LEN 4
+static bool ckpt_test_torn;
+
+static void ckpt_test_write(void *dst, const void *src, size_t len) {
+	memcpy(dst, src, (ckpt_test_torn ? len / 2 : len));
+}
+
+// Records the last block passed by the XMODEM receiver to the block function,
+// for the receiver tests.
+static uint8_t xmodem_test_block_num;
+static bool xmodem_test_block_ok;
+
+static bool xmodem_test_block(const uint8_t *data, size_t len, uint8_t block_num) {
+	xmodem_test_block_num = block_num;
+	xmodem_test_block_ok = (len == 128 && memcmp(data, test_data_b, len) == 0);
+	return true;
+}
+
+// Feed an XMODEM-CRC block, containing the first 128 bytes of test_data_b, to
+// the receiver byte-by-byte, as the UART ISR would.
+static void xmodem_test_send(const uint8_t block_num, const uint16_t crc) {
+	xmodem_rx_char(0x01); // SOH
+	xmodem_rx_char(block_num);
+	xmodem_rx_char(~block_num);
+	for(size_t i = 0; i < 128; i++) xmodem_rx_char(test_data_b[i]);
+	xmodem_rx_char((uint8_t)(crc >> 8));
+	xmodem_rx_char((uint8_t)crc);
+}
+
+void print_hex(const void *data, const size_t data_len) {
+	for(size_t i = 0; i < data_len; i++) {
+		if(i > 0) putchar(' ');
+		print_hex8(((const uint8_t *)data)[i]);
+	}
+}
+
+// Output the pass/fail result at the end of a verify() result line.
+void print_verdict(const bool pass) {
+	// Use ANSI terminal escape codes for highlighting pass/fail text.
+	static const char pass_str[] = " - \x1B[1m\x1B[32mPASS\x1B[0m\n"; // Bold green
+	static const char fail_str[] = " - \x1B[1m\x1B[31mFAIL\x1B[0m\n"; // Bold red
+
+	print_str(pass ? pass_str : fail_str);
+}
+
+// Compute a CRC over test data using an inline update function. For use only
+// within verify().
+#define verify_inline(crc, init, func, xorout) \
+	do { \
+		crc = init; \
+		for(size_t j = 0; j < sizeof(test_data_b); j++) { \
+			crc = func(crc, test_data_b[j]); \
+		} \
+		crc ^= xorout; \
+	} while(0)
+
+void verify(void) {
+	uint8_t crc_8_c, crc_8_asm;
+	uint16_t crc_16_c, crc_16_asm;
+	uint32_t crc_32_c, crc_32_asm;
+
+	print_str("verify()\n");
+
+	for(size_t i = 0; i < (sizeof(crc8_tests) / sizeof(crc8_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc8_tests[i].name);
+		print_str(":\n");
+		print_str("    data = ");
+		print_hex(crc8_tests[i].data, crc8_tests[i].data_len);
+		print_str(" (");
+		print_u32(crc8_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex8(crc8_tests[i].expected);
+		print_str("\n");
+
+		crc_8_c = crc8_tests[i].c_func.init_val;
+		crc_8_asm = crc8_tests[i].asm_func.init_val;
+
+		for(size_t n = 0; n < crc8_tests[i].data_len; n++) {
+			crc_8_c = (*crc8_tests[i].c_func.update_func)(crc_8_c, crc8_tests[i].data[n]);
+			crc_8_asm = (*crc8_tests[i].asm_func.update_func)(crc_8_asm, crc8_tests[i].data[n]);
+		}
+
+		crc_8_c ^= crc8_tests[i].c_func.xorout_val;
+		crc_8_asm ^= crc8_tests[i].asm_func.xorout_val;
+
+		print_str("    c = 0x");
+		print_hex8(crc_8_c);
+		print_verdict(crc_8_c == crc8_tests[i].expected);
+		print_str("    asm = 0x");
+		print_hex8(crc_8_asm);
+		print_verdict(crc_8_asm == crc8_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc16_tests) / sizeof(crc16_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_tests[i].name);
+		print_str(":\n");
+		print_str("    data = ");
+		print_hex(crc16_tests[i].data, crc16_tests[i].data_len);
+		print_str(" (");
+		print_u32(crc16_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex16(crc16_tests[i].expected);
+		print_str("\n");
+
+		crc_16_c = crc16_tests[i].c_func.init_val;
+		crc_16_asm = crc16_tests[i].asm_func.init_val;
+
+		for(size_t n = 0; n < crc16_tests[i].data_len; n++) {
+			crc_16_c = (*crc16_tests[i].c_func.update_func)(crc_16_c, crc16_tests[i].data[n]);
+			crc_16_asm = (*crc16_tests[i].asm_func.update_func)(crc_16_asm, crc16_tests[i].data[n]);
+		}
+
+		crc_16_c ^= crc16_tests[i].c_func.xorout_val;
+		crc_16_asm ^= crc16_tests[i].asm_func.xorout_val;
+
+		print_str("    c = 0x");
+		print_hex16(crc_16_c);
+		print_verdict(crc_16_c == crc16_tests[i].expected);
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == crc16_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc32_tests) / sizeof(crc32_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc32_tests[i].name);
+		print_str(":\n");
+		print_str("    data = ");
+		print_hex(crc32_tests[i].data, crc32_tests[i].data_len);
+		print_str(" (");
+		print_u32(crc32_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex32(crc32_tests[i].expected);
+		print_str("\n");
+
+		crc_32_c = crc32_tests[i].c_func.init_val;
+		crc_32_asm = crc32_tests[i].asm_func.init_val;
+
+		for(size_t n = 0; n < crc32_tests[i].data_len; n++) {
+			crc_32_c = (*crc32_tests[i].c_func.update_func)(crc_32_c, crc32_tests[i].data[n]);
+			crc_32_asm = (*crc32_tests[i].asm_func.update_func)(crc_32_asm, crc32_tests[i].data[n]);
+		}
+
+		crc_32_c ^= crc32_tests[i].c_func.xorout_val;
+		crc_32_asm ^= crc32_tests[i].asm_func.xorout_val;
+
+		print_str("    c = 0x");
+		print_hex32(crc_32_c);
+		print_verdict(crc_32_c == crc32_tests[i].expected);
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == crc32_tests[i].expected);
+	}
+
+#ifdef TEST_VARIANTS
+	for(size_t i = 0; i < (sizeof(crc8_variant_tests) / sizeof(crc8_variant_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc8_variant_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc8_variant_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex8(crc8_variant_tests[i].expected);
+		print_str("\n");
+
+		crc_8_c = crc8_variant_tests[i].c_func.init_val;
+		crc_8_asm = crc8_variant_tests[i].asm_func.init_val;
+
+		for(size_t n = 0; n < crc8_variant_tests[i].data_len; n++) {
+			crc_8_c = (*crc8_variant_tests[i].c_func.update_func)(crc_8_c, crc8_variant_tests[i].data[n]);
+			crc_8_asm = (*crc8_variant_tests[i].asm_func.update_func)(crc_8_asm, crc8_variant_tests[i].data[n]);
+		}
+
+		crc_8_c ^= crc8_variant_tests[i].c_func.xorout_val;
+		crc_8_asm ^= crc8_variant_tests[i].asm_func.xorout_val;
+
+		print_str("    c = 0x");
+		print_hex8(crc_8_c);
+		print_verdict(crc_8_c == crc8_variant_tests[i].expected);
+		print_str("    asm = 0x");
+		print_hex8(crc_8_asm);
+		print_verdict(crc_8_asm == crc_8_c && crc_8_asm == crc8_variant_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc16_variant_tests) / sizeof(crc16_variant_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_variant_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc16_variant_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex16(crc16_variant_tests[i].expected);
+		print_str("\n");
+
+		crc_16_c = crc16_variant_tests[i].c_func.init_val;
+		crc_16_asm = crc16_variant_tests[i].asm_func.init_val;
+
+		for(size_t n = 0; n < crc16_variant_tests[i].data_len; n++) {
+			crc_16_c = (*crc16_variant_tests[i].c_func.update_func)(crc_16_c, crc16_variant_tests[i].data[n]);
+			crc_16_asm = (*crc16_variant_tests[i].asm_func.update_func)(crc_16_asm, crc16_variant_tests[i].data[n]);
+		}
+
+		crc_16_c ^= crc16_variant_tests[i].c_func.xorout_val;
+		crc_16_asm ^= crc16_variant_tests[i].asm_func.xorout_val;
+
+		print_str("    c = 0x");
+		print_hex16(crc_16_c);
+		print_verdict(crc_16_c == crc16_variant_tests[i].expected);
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == crc_16_c && crc_16_asm == crc16_variant_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc32_variant_tests) / sizeof(crc32_variant_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc32_variant_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc32_variant_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex32(crc32_variant_tests[i].expected);
+		print_str("\n");
+
+		crc_32_c = crc32_variant_tests[i].c_func.init_val;
+		crc_32_asm = crc32_variant_tests[i].asm_func.init_val;
+
+		for(size_t n = 0; n < crc32_variant_tests[i].data_len; n++) {
+			crc_32_c = (*crc32_variant_tests[i].c_func.update_func)(crc_32_c, crc32_variant_tests[i].data[n]);
+			crc_32_asm = (*crc32_variant_tests[i].asm_func.update_func)(crc_32_asm, crc32_variant_tests[i].data[n]);
+		}
+
+		crc_32_c ^= crc32_variant_tests[i].c_func.xorout_val;
+		crc_32_asm ^= crc32_variant_tests[i].asm_func.xorout_val;
+
+		print_str("    c = 0x");
+		print_hex32(crc_32_c);
+		print_verdict(crc_32_c == crc32_variant_tests[i].expected);
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == crc_32_c && crc_32_asm == crc32_variant_tests[i].expected);
+	}
+#endif
+
+	// For bit-granular tests, split each data byte into 3, 1 and 4 bits, so
+	// that odd-sized and single bit updates are exercised, with the unused
+	// bits of the data byte being ignored.
+	for(size_t i = 0; i < (sizeof(crc8_bits_tests) / sizeof(crc8_bits_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc8_bits_tests[i].name);
+		print_str(":\n");
+		print_str("    data = ");
+		print_hex(crc8_bits_tests[i].data, crc8_bits_tests[i].data_len);
+		print_str(" (");
+		print_u32(crc8_bits_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex8(crc8_bits_tests[i].expected);
+		print_str("\n");
+
+		crc_8_asm = crc8_bits_tests[i].init_val;
+		for(size_t j = 0; j < crc8_bits_tests[i].data_len; j++) {
+			if(crc8_bits_tests[i].lsb_first) {
+				crc_8_asm = (*crc8_bits_tests[i].update_bits_func)(crc_8_asm, crc8_bits_tests[i].data[j], 3);
+				crc_8_asm = (*crc8_bits_tests[i].update_bits_func)(crc_8_asm, crc8_bits_tests[i].data[j] >> 3, 1);
+				crc_8_asm = (*crc8_bits_tests[i].update_bits_func)(crc_8_asm, crc8_bits_tests[i].data[j] >> 4, 4);
+			} else {
+				crc_8_asm = (*crc8_bits_tests[i].update_bits_func)(crc_8_asm, crc8_bits_tests[i].data[j] >> 5, 3);
+				crc_8_asm = (*crc8_bits_tests[i].update_bits_func)(crc_8_asm, crc8_bits_tests[i].data[j] >> 4, 1);
+				crc_8_asm = (*crc8_bits_tests[i].update_bits_func)(crc_8_asm, crc8_bits_tests[i].data[j], 4);
+			}
+		}
+		crc_8_asm ^= crc8_bits_tests[i].xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex8(crc_8_asm);
+		print_verdict(crc_8_asm == crc8_bits_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc16_bits_tests) / sizeof(crc16_bits_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_bits_tests[i].name);
+		print_str(":\n");
+		print_str("    data = ");
+		print_hex(crc16_bits_tests[i].data, crc16_bits_tests[i].data_len);
+		print_str(" (");
+		print_u32(crc16_bits_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex16(crc16_bits_tests[i].expected);
+		print_str("\n");
+
+		crc_16_asm = crc16_bits_tests[i].init_val;
+		for(size_t j = 0; j < crc16_bits_tests[i].data_len; j++) {
+			if(crc16_bits_tests[i].lsb_first) {
+				crc_16_asm = (*crc16_bits_tests[i].update_bits_func)(crc_16_asm, crc16_bits_tests[i].data[j], 3);
+				crc_16_asm = (*crc16_bits_tests[i].update_bits_func)(crc_16_asm, crc16_bits_tests[i].data[j] >> 3, 1);
+				crc_16_asm = (*crc16_bits_tests[i].update_bits_func)(crc_16_asm, crc16_bits_tests[i].data[j] >> 4, 4);
+			} else {
+				crc_16_asm = (*crc16_bits_tests[i].update_bits_func)(crc_16_asm, crc16_bits_tests[i].data[j] >> 5, 3);
+				crc_16_asm = (*crc16_bits_tests[i].update_bits_func)(crc_16_asm, crc16_bits_tests[i].data[j] >> 4, 1);
+				crc_16_asm = (*crc16_bits_tests[i].update_bits_func)(crc_16_asm, crc16_bits_tests[i].data[j], 4);
+			}
+		}
+		crc_16_asm ^= crc16_bits_tests[i].xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == crc16_bits_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc8_ram_tests) / sizeof(crc8_ram_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc8_ram_tests[i].name);
+		print_str(" (RAM LUT):\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex8(crc8_ram_tests[i].expected);
+		print_str("\n");
+
+		crc_lut_ram_init(crc8_ram_tests[i].type);
+		crc_8_asm = crc8_ram_tests[i].func.init_val;
+		for(size_t n = 0; n < sizeof(test_data_b); n++) {
+			crc_8_asm = (*crc8_ram_tests[i].func.update_func)(crc_8_asm, test_data_b[n]);
+		}
+		crc_8_asm ^= crc8_ram_tests[i].func.xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex8(crc_8_asm);
+		print_verdict(crc_8_asm == crc8_ram_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc16_ram_tests) / sizeof(crc16_ram_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_ram_tests[i].name);
+		print_str(" (RAM LUT):\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex16(crc16_ram_tests[i].expected);
+		print_str("\n");
+
+		crc_lut_ram_init(crc16_ram_tests[i].type);
+		crc_16_asm = crc16_ram_tests[i].func.init_val;
+		for(size_t n = 0; n < sizeof(test_data_b); n++) {
+			crc_16_asm = (*crc16_ram_tests[i].func.update_func)(crc_16_asm, test_data_b[n]);
+		}
+		crc_16_asm ^= crc16_ram_tests[i].func.xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == crc16_ram_tests[i].expected);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc32_ram_tests) / sizeof(crc32_ram_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc32_ram_tests[i].name);
+		print_str(" (RAM LUT):\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex32(crc32_ram_tests[i].expected);
+		print_str("\n");
+
+		crc_lut_ram_init(crc32_ram_tests[i].type);
+		crc_32_asm = crc32_ram_tests[i].func.init_val;
+		for(size_t n = 0; n < sizeof(test_data_b); n++) {
+			crc_32_asm = (*crc32_ram_tests[i].func.update_func)(crc_32_asm, test_data_b[n]);
+		}
+		crc_32_asm ^= crc32_ram_tests[i].func.xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == crc32_ram_tests[i].expected);
+	}
+
+	print_str("  inline:\n");
+	print_str("    data = (");
+	print_u32(sizeof(test_data_b));
+	print_str(" bytes)\n");
+	verify_inline(crc_8_asm, CRC8_1WIRE_INIT, crc8_1wire_update_inline, CRC8_1WIRE_XOROUT);
+	print_str("    crc8-1wire = 0x");
+	print_hex8(crc_8_asm);
+	print_verdict(crc_8_asm == 0xE3);
+	verify_inline(crc_8_asm, CRC8_J1850_INIT, crc8_j1850_update_inline, CRC8_J1850_XOROUT);
+	print_str("    crc8-j1850 = 0x");
+	print_hex8(crc_8_asm);
+	print_verdict(crc_8_asm == 0x28);
+	verify_inline(crc_8_asm, CRC8_AUTOSAR_INIT, crc8_autosar_update_inline, CRC8_AUTOSAR_XOROUT);
+	print_str("    crc8-autosar = 0x");
+	print_hex8(crc_8_asm);
+	print_verdict(crc_8_asm == 0xB3);
+	verify_inline(crc_16_asm, CRC16_ANSI_INIT, crc16_ansi_update_inline, CRC16_ANSI_XOROUT);
+	print_str("    crc16-ansi = 0x");
+	print_hex16(crc_16_asm);
+	print_verdict(crc_16_asm == 0x4173);
+	verify_inline(crc_16_asm, CRC16_CCITT_INIT, crc16_ccitt_update_inline, CRC16_CCITT_XOROUT);
+	print_str("    crc16-ccitt = 0x");
+	print_hex16(crc_16_asm);
+	print_verdict(crc_16_asm == 0x61DE);
+	verify_inline(crc_16_asm, CRC16_XMODEM_INIT, crc16_xmodem_update_inline, CRC16_XMODEM_XOROUT);
+	print_str("    crc16-xmodem = 0x");
+	print_hex16(crc_16_asm);
+	print_verdict(crc_16_asm == 0x2036);
+
+	for(size_t i = 0; i < (sizeof(crc16_memcpy_tests) / sizeof(crc16_memcpy_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_memcpy_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc16_memcpy_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex16(crc16_memcpy_tests[i].expected);
+		print_str("\n");
+
+		memset(memcpy_buf, 0, sizeof(memcpy_buf));
+		crc_16_asm = (*crc16_memcpy_tests[i].memcpy_func)(memcpy_buf, crc16_memcpy_tests[i].data, crc16_memcpy_tests[i].data_len, crc16_memcpy_tests[i].init_val);
+		crc_16_asm ^= crc16_memcpy_tests[i].xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == crc16_memcpy_tests[i].expected);
+		print_str("    copy");
+		print_verdict(memcmp(memcpy_buf, crc16_memcpy_tests[i].data, crc16_memcpy_tests[i].data_len) == 0);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc32_memcpy_tests) / sizeof(crc32_memcpy_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc32_memcpy_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc32_memcpy_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex32(crc32_memcpy_tests[i].expected);
+		print_str("\n");
+
+		memset(memcpy_buf, 0, sizeof(memcpy_buf));
+		crc_32_asm = (*crc32_memcpy_tests[i].memcpy_func)(memcpy_buf, crc32_memcpy_tests[i].data, crc32_memcpy_tests[i].data_len, crc32_memcpy_tests[i].init_val);
+		crc_32_asm ^= crc32_memcpy_tests[i].xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == crc32_memcpy_tests[i].expected);
+		print_str("    copy");
+		print_verdict(memcmp(memcpy_buf, crc32_memcpy_tests[i].data, crc32_memcpy_tests[i].data_len) == 0);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc8_crc16_update_buf_tests) / sizeof(crc8_crc16_update_buf_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc8_crc16_update_buf_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc8_crc16_update_buf_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex8(crc8_crc16_update_buf_tests[i].expected_8);
+		print_str(", 0x");
+		print_hex16(crc8_crc16_update_buf_tests[i].expected_16);
+		print_str("\n");
+
+		crc_8_asm = crc8_crc16_update_buf_tests[i].init_val_8;
+		crc_16_asm = crc8_crc16_update_buf_tests[i].init_val_16;
+		(*crc8_crc16_update_buf_tests[i].update_buf_func)(crc8_crc16_update_buf_tests[i].data, crc8_crc16_update_buf_tests[i].data_len, &crc_8_asm, &crc_16_asm);
+		crc_8_asm ^= crc8_crc16_update_buf_tests[i].xorout_val_8;
+		crc_16_asm ^= crc8_crc16_update_buf_tests[i].xorout_val_16;
+
+		print_str("    asm = 0x");
+		print_hex8(crc_8_asm);
+		print_str(", 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_8_asm == crc8_crc16_update_buf_tests[i].expected_8 && crc_16_asm == crc8_crc16_update_buf_tests[i].expected_16);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc16_crc32_update_buf_tests) / sizeof(crc16_crc32_update_buf_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_crc32_update_buf_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc16_crc32_update_buf_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex16(crc16_crc32_update_buf_tests[i].expected_16);
+		print_str(", 0x");
+		print_hex32(crc16_crc32_update_buf_tests[i].expected_32);
+		print_str("\n");
+
+		crc_16_asm = crc16_crc32_update_buf_tests[i].init_val_16;
+		crc_32_asm = crc16_crc32_update_buf_tests[i].init_val_32;
+		(*crc16_crc32_update_buf_tests[i].update_buf_func)(crc16_crc32_update_buf_tests[i].data, crc16_crc32_update_buf_tests[i].data_len, &crc_16_asm, &crc_32_asm);
+		crc_16_asm ^= crc16_crc32_update_buf_tests[i].xorout_val_16;
+		crc_32_asm ^= crc16_crc32_update_buf_tests[i].xorout_val_32;
+
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_str(", 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_16_asm == crc16_crc32_update_buf_tests[i].expected_16 && crc_32_asm == crc16_crc32_update_buf_tests[i].expected_32);
+	}
+
+	{
+		uint8_t batch_8[BATCH_TEST_COUNT], batch_ref_8[BATCH_TEST_COUNT];
+		uint16_t batch_16[BATCH_TEST_COUNT], batch_ref_16[BATCH_TEST_COUNT];
+
+		// Check each record's CRC from the batch functions against one
+		// computed record-by-record with the reference functions.
+		for(size_t i = 0; i < BATCH_TEST_COUNT; i++) {
+			crc_8_c = crc8_autosar_init();
+			crc_16_c = crc16_ccitt_init();
+			for(size_t n = 0; n < BATCH_TEST_REC_LEN; n++) {
+				crc_8_c = crc8_autosar_update_ref(crc_8_c, test_data_b[(i * BATCH_TEST_STRIDE) + n]);
+				crc_16_c = crc16_ccitt_update_ref(crc_16_c, test_data_b[(i * BATCH_TEST_STRIDE) + n]);
+			}
+			batch_ref_8[i] = crc8_autosar_final(crc_8_c);
+			batch_ref_16[i] = crc16_ccitt_final(crc_16_c);
+		}
+
+		for(size_t i = 0; i < (sizeof(crc8_batch_tests) / sizeof(crc8_batch_tests[0])); i++) {
+			memset(batch_8, 0, sizeof(batch_8));
+			(*crc8_batch_tests[i].batch_func)(test_data_b, BATCH_TEST_STRIDE, BATCH_TEST_REC_LEN, BATCH_TEST_COUNT, batch_8);
+
+			print_str("  ");
+			print_str(crc8_batch_tests[i].name);
+			print_str(":\n");
+			print_str("    records = ");
+			print_u32(BATCH_TEST_COUNT);
+			print_str(" x ");
+			print_u32(BATCH_TEST_REC_LEN);
+			print_str(" bytes (stride ");
+			print_u32(BATCH_TEST_STRIDE);
+			print_str(")\n");
+			print_str("    asm = 0x");
+			print_hex8(batch_8[0]);
+			print_str(" ... 0x");
+			print_hex8(batch_8[BATCH_TEST_COUNT - 1]);
+			print_verdict(memcmp(batch_8, batch_ref_8, sizeof(batch_8)) == 0);
+		}
+
+		for(size_t i = 0; i < (sizeof(crc16_batch_tests) / sizeof(crc16_batch_tests[0])); i++) {
+			memset(batch_16, 0, sizeof(batch_16));
+			(*crc16_batch_tests[i].batch_func)(test_data_b, BATCH_TEST_STRIDE, BATCH_TEST_REC_LEN, BATCH_TEST_COUNT, batch_16);
+
+			print_str("  ");
+			print_str(crc16_batch_tests[i].name);
+			print_str(":\n");
+			print_str("    records = ");
+			print_u32(BATCH_TEST_COUNT);
+			print_str(" x ");
+			print_u32(BATCH_TEST_REC_LEN);
+			print_str(" bytes (stride ");
+			print_u32(BATCH_TEST_STRIDE);
+			print_str(")\n");
+			print_str("    asm = 0x");
+			print_hex16(batch_16[0]);
+			print_str(" ... 0x");
+			print_hex16(batch_16[BATCH_TEST_COUNT - 1]);
+			print_verdict(memcmp(batch_16, batch_ref_16, sizeof(batch_16)) == 0);
+		}
+	}
+
+	memcpy(block512_buf, test_data_b, sizeof(test_data_b));
+	memcpy(block512_buf + sizeof(test_data_b), test_data_b, sizeof(test_data_b));
+
+	crc_16_c = crc16_xmodem_init();
+	for(size_t i = 0; i < sizeof(block512_buf); i++) {
+		crc_16_c = crc16_xmodem_update_ref(crc_16_c, block512_buf[i]);
+	}
+	crc_16_c = crc16_xmodem_final(crc_16_c);
+
+	for(size_t i = 0; i < (sizeof(crc16_block512_tests) / sizeof(crc16_block512_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc16_block512_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(sizeof(block512_buf));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x6548\n");
+
+		crc_16_asm = (*crc16_block512_tests[i].block512_func)(block512_buf);
+
+		print_str("    c = 0x");
+		print_hex16(crc_16_c);
+		print_verdict(crc_16_c == 0x6548);
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == 0x6548);
+	}
+
+	print_str("  crc-hash16-str:\n");
+	print_str("    data = \"123456789\"\n");
+	print_str("    expected = 0x29B1\n");
+	crc_16_asm = crc_hash16_str("123456789");
+	print_str("    asm = 0x");
+	print_hex16(crc_16_asm);
+	print_verdict(crc_16_asm == 0x29B1 && crc_hash16_buf("123456789", 9) == 0x29B1);
+
+	print_str("  crc-hash8-str:\n");
+	print_str("    data = \"123456789\"\n");
+	print_str("    expected = 0xDF\n");
+	crc_8_asm = crc_hash8_str("123456789");
+	print_str("    asm = 0x");
+	print_hex8(crc_8_asm);
+	print_verdict(crc_8_asm == 0xDF && crc_hash8_buf("123456789", 9) == 0xDF);
+
+	{
+		bool ok_16 = true, ok_8 = true;
+
+		// Every name must be found at its own index, and an unknown name
+		// (whose hash matches none of them) must not be found.
+		for(uint8_t i = 0; i < HASH_TEST_COUNT; i++) {
+			if(crc_hash16_lookup(&cmd_hash_table, crc_hash16_str(hash_test_names[i])) != i) ok_16 = false;
+			if(i < HASH_TEST_COUNT_8 && crc_hash8_lookup(&id8_hash_table, crc_hash8_str(hash_test_names[i])) != i) ok_8 = false;
+		}
+		if(crc_hash16_lookup(&cmd_hash_table, crc_hash16_str("unknown")) != CRC_HASH_EMPTY) ok_16 = false;
+		if(crc_hash8_lookup(&id8_hash_table, crc_hash8_str("unknown")) != CRC_HASH_EMPTY) ok_8 = false;
+
+		print_str("  crc-hash16-lookup:\n");
+		print_str("    names = ");
+		print_u32(HASH_TEST_COUNT);
+		print_str(" + unknown\n");
+		print_str("    asm = ");
+		print_str(ok_16 ? "all found" : "mismatch");
+		print_verdict(ok_16);
+		print_str("  crc-hash8-lookup:\n");
+		print_str("    names = ");
+		print_u32(HASH_TEST_COUNT_8);
+		print_str(" + unknown\n");
+		print_str("    asm = ");
+		print_str(ok_8 ? "all found" : "mismatch");
+		print_verdict(ok_8);
+	}
+
+	// Far CRC functions take a 24-bit address, but the test data is in the
+	// lower 64KB, so it can be used for these as well.
+	for(size_t i = 0; i < (sizeof(crc32_far_tests) / sizeof(crc32_far_tests[0])); i++) {
+		print_str("  ");
+		print_str(crc32_far_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x");
+		print_hex32(crc32_far_tests[i].expected);
+		print_str("\n");
+
+		crc_32_asm = (*crc32_far_tests[i].update_far_func)((uint16_t)test_data_b, sizeof(test_data_b), crc32_far_tests[i].init_val);
+		crc_32_asm ^= crc32_far_tests[i].xorout_val;
+
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == crc32_far_tests[i].expected);
+	}
+
+	{
+		static const char * const result_strs[] = { "ok", "bad trailer", "bad crc" };
+		static const struct {
+			char *name;
+			crc_image_verify_mode_t mode;
+			bool corrupt_image;
+			bool corrupt_trailer;
+			crc_image_result_t expected;
+		} image_tests[] = {
+			{ "image-verify-full", CRC_IMAGE_VERIFY_FULL, false, false, CRC_IMAGE_OK },
+			{ "image-verify-blocks", CRC_IMAGE_VERIFY_BLOCKS, false, false, CRC_IMAGE_OK },
+			{ "image-verify-full", CRC_IMAGE_VERIFY_FULL, true, false, CRC_IMAGE_BAD_CRC },
+			{ "image-verify-blocks", CRC_IMAGE_VERIFY_BLOCKS, true, false, CRC_IMAGE_BAD_CRC },
+			{ "image-verify-blocks", CRC_IMAGE_VERIFY_BLOCKS, false, true, CRC_IMAGE_BAD_TRAILER }
+		};
+		crc_image_result_t result;
+
+		// Use a copy of the test data in RAM as the image, so that it can be
+		// corrupted. The trailer is also in RAM, which is fine, as the image
+		// functions can read from any address.
+		for(size_t i = 0; i < (sizeof(image_tests) / sizeof(image_tests[0])); i++) {
+			memcpy(memcpy_buf, test_data_b, sizeof(test_data_b));
+			image_trailer_build();
+			if(image_tests[i].corrupt_image) memcpy_buf[200] ^= 0x04;
+			if(image_tests[i].corrupt_trailer) image_trailer_buf[sizeof(crc_image_trailer_t)] ^= 0x80;
+
+			print_str("  ");
+			print_str(image_tests[i].name);
+			print_str(":\n");
+			print_str("    data = (");
+			print_u32(sizeof(test_data_b));
+			print_str(" bytes, ");
+			print_u32(IMAGE_TEST_BLOCK_COUNT);
+			print_str(" blocks)");
+			print_str(image_tests[i].corrupt_image ? ", corrupt image" : "");
+			print_str(image_tests[i].corrupt_trailer ? ", corrupt trailer" : "");
+			print_str("\n");
+			print_str("    expected = ");
+			print_str(result_strs[image_tests[i].expected]);
+			print_str("\n");
+
+			result = crc_image_verify((uint16_t)memcpy_buf, (uint16_t)image_trailer_buf, image_tests[i].mode);
+
+			print_str("    asm = ");
+			print_str(result_strs[result]);
+			print_verdict(result == image_tests[i].expected);
+		}
+	}
+
+	for(size_t i = 0; i < (sizeof(fletcher16_buf_tests) / sizeof(fletcher16_buf_tests[0])); i++) {
+		print_str("  ");
+		print_str(fletcher16_buf_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x4677\n");
+		crc_16_asm = (*fletcher16_buf_tests[i].update_buf_func)(test_data_b, sizeof(test_data_b), fletcher16_init());
+		print_str("    asm = 0x");
+		print_hex16(crc_16_asm);
+		print_verdict(crc_16_asm == 0x4677);
+	}
+
+	for(size_t i = 0; i < (sizeof(adler32_buf_tests) / sizeof(adler32_buf_tests[0])); i++) {
+		print_str("  ");
+		print_str(adler32_buf_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0xB7E879FE\n");
+		crc_32_asm = (*adler32_buf_tests[i].update_buf_func)(test_data_b, sizeof(test_data_b), adler32_init());
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == 0xB7E879FE);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc_check_tests) / sizeof(crc_check_tests[0])); i++) {
+		bool result;
+
+		print_str("  ");
+		print_str(crc_check_tests[i].name);
+		print_str(":\n");
+		print_str("    frame = ");
+		print_hex(crc_check_tests[i].data, crc_check_tests[i].data_len);
+		print_str(" (");
+		print_u32(crc_check_tests[i].data_len);
+		print_str(" bytes)\n");
+		print_str("    expected = ");
+		print_str(crc_check_tests[i].expected ? "valid" : "invalid");
+		print_str("\n");
+
+		result = (*crc_check_tests[i].check_func)(crc_check_tests[i].data, crc_check_tests[i].data_len);
+
+		print_str("    asm = ");
+		print_str(result ? "valid" : "invalid");
+		print_verdict(result == crc_check_tests[i].expected);
+	}
+
+	{
+		size_t offset = 0;
+		bool found;
+
+		print_str("  crc16-ansi-rolling:\n");
+		print_str("    data = ");
+		print_hex(test_stream_crc16_ansi, sizeof(test_stream_crc16_ansi));
+		print_str(" (");
+		print_u32(sizeof(test_stream_crc16_ansi));
+		print_str(" bytes, ");
+		print_u32(sizeof(test_frame_crc16_ansi));
+		print_str(" byte window)\n");
+		print_str("    expected = offset 6\n");
+
+		crc16_ansi_rolling_init(&crc16_ansi_rolling, sizeof(test_frame_crc16_ansi));
+		found = crc16_ansi_rolling_find(&crc16_ansi_rolling, test_stream_crc16_ansi, sizeof(test_stream_crc16_ansi), &offset);
+
+		print_str("    asm = ");
+		print_str(found ? "offset" : "not found");
+		print_str(" ");
+		print_u32(offset);
+		print_verdict(found && offset == 6);
+	}
+
+	{
+		static const char * const result_strs[] = { "ok", "fixed", "failed" };
+		crc_correct_result_t result;
+
+		// Flip one bit of a good frame, and then another, checking the first
+		// is corrected and the second is detected but not mis-corrected.
+		memcpy(memcpy_buf, test_frame_crc16_ansi, sizeof(test_frame_crc16_ansi));
+		memcpy_buf[3] ^= 0x10;
+
+		print_str("  crc16-ansi-correct:\n");
+		print_str("    frame = ");
+		print_hex(memcpy_buf, sizeof(test_frame_crc16_ansi));
+		print_str(" (");
+		print_u32(sizeof(test_frame_crc16_ansi));
+		print_str(" bytes)\n");
+		print_str("    expected = fixed\n");
+
+		result = crc16_ansi_correct(memcpy_buf, sizeof(test_frame_crc16_ansi));
+
+		print_str("    asm = ");
+		print_str(result_strs[result]);
+		print_verdict(result == CRC_CORRECT_FIXED && memcmp(memcpy_buf, test_frame_crc16_ansi, sizeof(test_frame_crc16_ansi)) == 0);
+
+		memcpy_buf[3] ^= 0x10;
+		memcpy_buf[8] ^= 0x01;
+
+		print_str("  crc16-ansi-correct:\n");
+		print_str("    frame = ");
+		print_hex(memcpy_buf, sizeof(test_frame_crc16_ansi));
+		print_str(" (");
+		print_u32(sizeof(test_frame_crc16_ansi));
+		print_str(" bytes)\n");
+		print_str("    expected = failed\n");
+
+		result = crc16_ansi_correct(memcpy_buf, sizeof(test_frame_crc16_ansi));
+
+		print_str("    asm = ");
+		print_str(result_strs[result]);
+		print_verdict(result == CRC_CORRECT_FAILED);
+	}
+
+	for(size_t i = 0; i < (sizeof(crc_job_tests) / sizeof(crc_job_tests[0])); i++) {
+		crc_job_t job;
+
+		print_str("  ");
+		print_str(crc_job_tests[i].name);
+		print_str(":\n");
+		print_str("    data = (");
+		print_u32(crc_job_tests[i].data_len);
+		print_str(" bytes, ");
+		print_u32(crc_job_tests[i].slice_len);
+		print_str(" byte slices)\n");
+		print_str("    expected = 0x");
+		print_hex32(crc_job_tests[i].expected);
+		print_str("\n");
+
+		crc_job_start(&job, crc_job_tests[i].type, crc_job_tests[i].data, crc_job_tests[i].data_len);
+		while(!crc_job_step(&job, crc_job_tests[i].slice_len));
+		crc_32_asm = crc_job_result(&job);
+
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_verdict(crc_32_asm == crc_job_tests[i].expected);
+	}
+
+	{
+		static crc_job_ckpt_t ring[CKPT_TEST_RING_LEN];
+		crc_job_t job;
+		uint32_t offset;
+		bool loaded;
+
+		// Run a CRC32 job over test_data_b in 32-byte chunks, checkpointing
+		// after each, with a simulated power failure part-way through writing
+		// the checkpoint at offset 160. Then resume from the last complete
+		// checkpoint, as would happen after a reset.
+		memset(ring, 0, sizeof(ring));
+		crc_job_start(&job, CRC_TYPE_CRC32, NULL, 0);
+		for(offset = 0; offset < sizeof(test_data_b); offset += 32) {
+			crc_job_resume(&job, test_data_b + offset, 32);
+			while(!crc_job_step(&job, 32));
+			ckpt_test_torn = (offset + 32 == 160);
+			crc_job_ckpt_save(ring, CKPT_TEST_RING_LEN, &job, offset + 32, ckpt_test_write);
+			if(ckpt_test_torn) break;
+		}
+
+		loaded = crc_job_ckpt_load(ring, CKPT_TEST_RING_LEN, &job, &offset);
+
+		print_str("  crc32-job-ckpt:\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes, interrupted at 160)\n");
+		print_str("    expected = 0x791FF31F, resumed from 128\n");
+
+		if(loaded) {
+			crc_job_resume(&job, test_data_b + offset, sizeof(test_data_b) - offset);
+			while(!crc_job_step(&job, 32));
+		}
+		crc_32_asm = crc_job_result(&job);
+
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_str(", resumed from ");
+		print_u32(offset);
+		print_verdict(loaded && offset == 128 && crc_32_asm == 0x791FF31F);
+
+		// Once cleared, there should be nothing to resume.
+		crc_job_ckpt_clear(ring, CKPT_TEST_RING_LEN, ckpt_test_write);
+		loaded = crc_job_ckpt_load(ring, CKPT_TEST_RING_LEN, &job, &offset);
+
+		print_str("  crc32-job-ckpt-clear:\n");
+		print_str("    expected = none\n");
+		print_str("    asm = ");
+		print_str(loaded ? "loaded" : "none");
+		print_verdict(!loaded);
+	}
+
+	{
+		crc_job_ckpt_t *ring = (crc_job_ckpt_t *)EEPROM_START;
+		crc_job_t job;
+		uint32_t offset;
+		bool loaded;
+
+		// Checkpoint the same job to a ring in data EEPROM with eeprom_write(),
+		// up to offset 128, then read the newest checkpoint back and resume from
+		// it. The ring is cleared before and after, so that the result does not
+		// depend on anything left in EEPROM by a previous run.
+		crc_job_ckpt_clear(ring, CKPT_TEST_RING_LEN, eeprom_write);
+		crc_job_start(&job, CRC_TYPE_CRC32, NULL, 0);
+		for(offset = 0; offset < 128; offset += 32) {
+			crc_job_resume(&job, test_data_b + offset, 32);
+			while(!crc_job_step(&job, 32));
+			crc_job_ckpt_save(ring, CKPT_TEST_RING_LEN, &job, offset + 32, eeprom_write);
+		}
+
+		crc_job_start(&job, CRC_TYPE_CRC16_ANSI, NULL, 0);
+		loaded = crc_job_ckpt_load(ring, CKPT_TEST_RING_LEN, &job, &offset);
+
+		print_str("  crc32-job-ckpt-eeprom:\n");
+		print_str("    data = (");
+		print_u32(sizeof(test_data_b));
+		print_str(" bytes)\n");
+		print_str("    expected = 0x791FF31F, resumed from 128\n");
+
+		if(loaded) {
+			crc_job_resume(&job, test_data_b + offset, sizeof(test_data_b) - offset);
+			while(!crc_job_step(&job, 32));
+		}
+		crc_32_asm = crc_job_result(&job);
+
+		print_str("    asm = 0x");
+		print_hex32(crc_32_asm);
+		print_str(", resumed from ");
+		print_u32(offset);
+		print_verdict(loaded && offset == 128 && crc_32_asm == 0x791FF31F);
+
+		crc_job_ckpt_clear(ring, CKPT_TEST_RING_LEN, eeprom_write);
+	}
+
+	{
+		static const char * const status_strs[] = { "none", "ok", "bad" };
+		static const struct {
+			const uint8_t *data;
+			size_t data_len;
+			modbus_rtu_rx_status_t expected;
+		} modbus_tests[] = {
+			{ test_frame_crc16_ansi, sizeof(test_frame_crc16_ansi), MODBUS_RTU_RX_OK },
+			{ test_frame_crc32_bad, sizeof(test_frame_crc32_bad), MODBUS_RTU_RX_BAD }
+		};
+		const uint8_t *frame;
+		size_t len;
+		modbus_rtu_rx_status_t status;
+
+		// Feed frames to the receiver byte-by-byte, as the UART ISR would, then
+		// simulate the end-of-frame timer firing. This program does not install
+		// the ISRs, so disable the interrupts that initialisation enables.
+		modbus_rtu_init(UART_BAUD_115200);
+		TIM2_IER = 0;
+		UART1_CR2 &= ~(1U << UART1_CR2_RIEN);
+
+		for(size_t i = 0; i < (sizeof(modbus_tests) / sizeof(modbus_tests[0])); i++) {
+			print_str("  modbus-rtu-receive:\n");
+			print_str("    frame = ");
+			print_hex(modbus_tests[i].data, modbus_tests[i].data_len);
+			print_str(" (");
+			print_u32(modbus_tests[i].data_len);
+			print_str(" bytes)\n");
+			print_str("    expected = ");
+			print_str(status_strs[modbus_tests[i].expected]);
+			print_str("\n");
+
+			(void)modbus_rtu_receive(&frame, &len);
+			for(size_t n = 0; n < modbus_tests[i].data_len; n++) {
+				modbus_rtu_rx_char(modbus_tests[i].data[n]);
+			}
+			modbus_rtu_timer_isr();
+			status = modbus_rtu_receive(&frame, &len);
+
+			print_str("    asm = ");
+			print_str(status_strs[status]);
+			print_verdict(status == modbus_tests[i].expected);
+		}
+	}
+
+	{
+		static const char * const status_strs[] = { "busy", "done", "cancelled", "failed" };
+		xmodem_status_t status;
+
+		// Note: the receiver transmits its handshake characters (C, ACK, NAK)
+		// to the UART, so they will appear amongst the output. As for Modbus,
+		// blocks are fed to the receiver directly, so disable the UART receive
+		// interrupt that initialisation enables.
+		xmodem_init(xmodem_test_block);
+		UART1_CR2 &= ~(1U << UART1_CR2_RIEN);
+
+		print_str("  xmodem-receive:\n");
+		print_str("    block = 1, crc = 0x96CF (128 bytes)\n");
+		print_str("    expected = delivered\n");
+		xmodem_test_block_num = 0;
+		xmodem_test_send(1, 0x96CF);
+		status = xmodem_poll();
+		print_str("    asm = ");
+		print_str(xmodem_test_block_num == 1 ? "delivered" : "not delivered");
+		print_verdict(status == XMODEM_BUSY && xmodem_test_block_num == 1 && xmodem_test_block_ok);
+
+		print_str("  xmodem-receive:\n");
+		print_str("    block = 2, crc = 0x96CE (128 bytes)\n");
+		print_str("    expected = not delivered\n");
+		xmodem_test_block_num = 0;
+		xmodem_test_send(2, 0x96CE);
+		status = xmodem_poll();
+		print_str("    asm = ");
+		print_str(xmodem_test_block_num != 0 ? "delivered" : "not delivered");
+		print_verdict(status == XMODEM_BUSY && xmodem_test_block_num == 0);
+
+		print_str("  xmodem-receive:\n");
+		print_str("    eot\n");
+		print_str("    expected = ");
+		print_str(status_strs[XMODEM_DONE]);
+		print_str("\n");
+		xmodem_rx_char(0x04); // EOT
+		status = xmodem_poll();
+		print_str("    asm = ");
+		print_str(status_strs[status]);
+		print_verdict(status == XMODEM_DONE);
+	}
+}
+
+// Benchmark a function by calling it directly (or inline), rather than through
+// a function pointer. For use only within benchmark().
+#define benchmark_call(label, method, crc, init, func, xorout) \
+	do { \
+		print_str("  "); \
+		print_str(label); \
+		print_str(" ("); \
+		print_str(method); \
+		print_str(")\n"); \
+		n = iters; \
+		crc = init; \
+		benchmark_marker_start(); \
+		while(n--) { \
+			crc = func(crc, 0x55); \
+		} \
+		benchmark_marker_end(); \
+		crc ^= xorout; \
+	} while(0)
+
+// Adapt the 'bits' functions to the form of an 'update' function, giving all 8
+// bits of the data byte, so that they may be benchmarked with benchmark_call().
+#define crc8_1wire_update_bits8(crc, data) crc8_1wire_update_bits(crc, data, 8)
+#define crc8_j1850_update_bits8(crc, data) crc8_j1850_update_bits(crc, data, 8)
+#define crc8_autosar_update_bits8(crc, data) crc8_autosar_update_bits(crc, data, 8)
+#define crc16_ansi_update_bits8(crc, data) crc16_ansi_update_bits(crc, data, 8)
+#define crc16_ccitt_update_bits8(crc, data) crc16_ccitt_update_bits(crc, data, 8)
+
+void benchmark(const uint16_t iters) {
 	uint8_t crc_8;
 	uint16_t crc_16, n;
 	uint32_t crc_32;
 
-	printf("benchmark()\n");
+	print_str("benchmark()\n");
+	print_str("  iterations = ");
+	print_u32(iters);
+	print_str("\n");
+
+	// Each run is labelled with the name of the function and how it is called,
+	// so that tools/bench.py can match them up with the cycle counts output by
+	// uCsim. The first run of each width (and for each method of calling) is of
+	// a null function, giving the baseline overhead.
 
-	for(size_t i = 0; i < (sizeof(crc8_functions) / sizeof(crc8_functions[0])); i++) {
+	for(size_t i = 0; i < (sizeof(crc8_benchmarks) / sizeof(crc8_benchmarks[0])); i++) {
+		print_str("  ");
+		print_str(crc8_benchmarks[i].name);
+		print_str(" (ptr)\n");
 		n = iters;
-		crc_8 = crc8_functions[i].init_val;
+		crc_8 = crc8_benchmarks[i].func.init_val;
 		benchmark_marker_start();
 		while(n--) {
-			crc_8 = (*crc8_functions[i].update_func)(crc_8, 0x55);
+			crc_8 = (*crc8_benchmarks[i].func.update_func)(crc_8, 0x55);
 		}
 		benchmark_marker_end();
-		crc_8 ^= crc8_functions[i].xorout_val;
+		crc_8 ^= crc8_benchmarks[i].func.xorout_val;
 	}
 
-	for(size_t i = 0; i < (sizeof(crc16_functions) / sizeof(crc16_functions[0])); i++) {
+	benchmark_call("null8", "direct", crc_8, 0, crc8_update_null, 0);
+	benchmark_call("crc8-1wire-asm", "direct", crc_8, CRC8_1WIRE_INIT, crc8_1wire_update, CRC8_1WIRE_XOROUT);
+	benchmark_call("crc8-j1850-asm", "direct", crc_8, CRC8_J1850_INIT, crc8_j1850_update, CRC8_J1850_XOROUT);
+	benchmark_call("crc8-autosar-asm", "direct", crc_8, CRC8_AUTOSAR_INIT, crc8_autosar_update, CRC8_AUTOSAR_XOROUT);
+	benchmark_call("crc8-1wire-bits", "direct", crc_8, CRC8_1WIRE_INIT, crc8_1wire_update_bits8, CRC8_1WIRE_XOROUT);
+	benchmark_call("crc8-j1850-bits", "direct", crc_8, CRC8_J1850_INIT, crc8_j1850_update_bits8, CRC8_J1850_XOROUT);
+	benchmark_call("crc8-autosar-bits", "direct", crc_8, CRC8_AUTOSAR_INIT, crc8_autosar_update_bits8, CRC8_AUTOSAR_XOROUT);
+
+	crc_lut_ram_init(CRC_TYPE_CRC8_1WIRE);
+	benchmark_call("crc8-1wire-ram", "direct", crc_8, CRC8_1WIRE_INIT, crc8_1wire_update_ram, CRC8_1WIRE_XOROUT);
+	crc_lut_ram_init(CRC_TYPE_CRC8_J1850);
+	benchmark_call("crc8-j1850-ram", "direct", crc_8, CRC8_J1850_INIT, crc8_j1850_update_ram, CRC8_J1850_XOROUT);
+
+	benchmark_call("null8", "inline", crc_8, 0, crc8_update_null_inline, 0);
+	benchmark_call("crc8-1wire-asm", "inline", crc_8, CRC8_1WIRE_INIT, crc8_1wire_update_inline, CRC8_1WIRE_XOROUT);
+	benchmark_call("crc8-j1850-asm", "inline", crc_8, CRC8_J1850_INIT, crc8_j1850_update_inline, CRC8_J1850_XOROUT);
+	benchmark_call("crc8-autosar-asm", "inline", crc_8, CRC8_AUTOSAR_INIT, crc8_autosar_update_inline, CRC8_AUTOSAR_XOROUT);
+
+	for(size_t i = 0; i < (sizeof(crc16_benchmarks) / sizeof(crc16_benchmarks[0])); i++) {
+		print_str("  ");
+		print_str(crc16_benchmarks[i].name);
+		print_str(" (ptr)\n");
 		n = iters;
-		crc_16 = crc16_functions[i].init_val;
+		crc_16 = crc16_benchmarks[i].func.init_val;
 		benchmark_marker_start();
 		while(n--) {
-			crc_16 = (*crc16_functions[i].update_func)(crc_16, 0x55);
+			crc_16 = (*crc16_benchmarks[i].func.update_func)(crc_16, 0x55);
 		}
 		benchmark_marker_end();
-		crc_16 ^= crc16_functions[i].xorout_val;
+		crc_16 ^= crc16_benchmarks[i].func.xorout_val;
 	}
 
-	for(size_t i = 0; i < (sizeof(crc32_functions) / sizeof(crc32_functions[0])); i++) {
+	benchmark_call("null16", "direct", crc_16, 0, crc16_update_null, 0);
+	benchmark_call("crc16-ansi-asm", "direct", crc_16, CRC16_ANSI_INIT, crc16_ansi_update, CRC16_ANSI_XOROUT);
+	benchmark_call("crc16-ccitt-asm", "direct", crc_16, CRC16_CCITT_INIT, crc16_ccitt_update, CRC16_CCITT_XOROUT);
+	benchmark_call("fletcher16-asm", "direct", crc_16, FLETCHER16_INIT, fletcher16_update, 0);
+	benchmark_call("crc16-ansi-bits", "direct", crc_16, CRC16_ANSI_INIT, crc16_ansi_update_bits8, CRC16_ANSI_XOROUT);
+	benchmark_call("crc16-ccitt-bits", "direct", crc_16, CRC16_CCITT_INIT, crc16_ccitt_update_bits8, CRC16_CCITT_XOROUT);
+
+	crc_lut_ram_init(CRC_TYPE_CRC16_ANSI);
+	benchmark_call("crc16-ansi-ram", "direct", crc_16, CRC16_ANSI_INIT, crc16_ansi_update_ram, CRC16_ANSI_XOROUT);
+	crc_lut_ram_init(CRC_TYPE_CRC16_CCITT);
+	benchmark_call("crc16-ccitt-ram", "direct", crc_16, CRC16_CCITT_INIT, crc16_ccitt_update_ram, CRC16_CCITT_XOROUT);
+
+	benchmark_call("null16", "inline", crc_16, 0, crc16_update_null_inline, 0);
+	benchmark_call("crc16-ansi-asm", "inline", crc_16, CRC16_ANSI_INIT, crc16_ansi_update_inline, CRC16_ANSI_XOROUT);
+	benchmark_call("crc16-ccitt-asm", "inline", crc_16, CRC16_CCITT_INIT, crc16_ccitt_update_inline, CRC16_CCITT_XOROUT);
+
+	for(size_t i = 0; i < (sizeof(crc32_benchmarks) / sizeof(crc32_benchmarks[0])); i++) {
+		print_str("  ");
+		print_str(crc32_benchmarks[i].name);
+		print_str(" (ptr)\n");
 		n = iters;
-		crc_32 = crc32_functions[i].init_val;
+		crc_32 = crc32_benchmarks[i].func.init_val;
 		benchmark_marker_start();
 		while(n--) {
-			crc_32 = (*crc32_functions[i].update_func)(crc_32, 0x55);
+			crc_32 = (*crc32_benchmarks[i].func.update_func)(crc_32, 0x55);
 		}
 		benchmark_marker_end();
-		crc_32 ^= crc32_functions[i].xorout_val;
+		crc_32 ^= crc32_benchmarks[i].func.xorout_val;
 	}
+
+	benchmark_call("null32", "direct", crc_32, 0, crc32_update_null, 0);
+	benchmark_call("crc32-asm", "direct", crc_32, CRC32_INIT, crc32_update, CRC32_XOROUT);
+	benchmark_call("crc32-posix-asm", "direct", crc_32, CRC32_POSIX_INIT, crc32_posix_update, CRC32_POSIX_XOROUT);
+	benchmark_call("adler32-asm", "direct", crc_32, ADLER32_INIT, adler32_update, 0);
+
+	crc_lut_ram_init(CRC_TYPE_CRC32);
+	benchmark_call("crc32-ram", "direct", crc_32, CRC32_INIT, crc32_update_ram, CRC32_XOROUT);
+	crc_lut_ram_init(CRC_TYPE_CRC32_POSIX);
+	benchmark_call("crc32-posix-ram", "direct", crc_32, CRC32_POSIX_INIT, crc32_posix_update_ram, CRC32_POSIX_XOROUT);
+}
+
+// Print the label of a benchmark run, in the same form as benchmark(), for
+// tools/bench.py.
+static void benchmark_label(const char *name, const char *method) {
+	print_str("  ");
+	print_str(name);
+	print_str(" (");
+	print_str(method);
+	print_str(")\n");
+}
+
+// Print the number of bytes processed by each of the following benchmark runs,
+// for tools/bench.py to give cycles per byte.
+static void benchmark_bytes(const uint16_t bytes) {
+	print_str("  iterations = ");
+	print_u32(bytes);
+	print_str("\n");
+}
+
+void benchmark_update_buf(void) {
+	uint8_t crc_8;
+	uint16_t crc_16;
+	uint32_t crc_32;
+
+	print_str("benchmark_update_buf()\n");
+	benchmark_bytes(sizeof(test_data_b));
+
+	// Compare computing a CRC16-CCITT and a CRC32 over the same data with two
+	// separate passes versus a single combined pass.
+	benchmark_label("crc16-ccitt+crc32-asm", "direct");
+	crc_16 = crc16_ccitt_init();
+	crc_32 = crc32_init();
+	benchmark_marker_start();
+	for(size_t i = 0; i < sizeof(test_data_b); i++) {
+		crc_16 = crc16_ccitt_update(crc_16, test_data_b[i]);
+	}
+	for(size_t i = 0; i < sizeof(test_data_b); i++) {
+		crc_32 = crc32_update(crc_32, test_data_b[i]);
+	}
+	benchmark_marker_end();
+
+	benchmark_label("crc16-ccitt-crc32-asm", "buf");
+	crc_16 = crc16_ccitt_init();
+	crc_32 = crc32_init();
+	benchmark_marker_start();
+	crc16_ccitt_crc32_update_buf(test_data_b, sizeof(test_data_b), &crc_16, &crc_32);
+	benchmark_marker_end();
+
+	// Then time each of the other functions that process a whole buffer in a
+	// single call, over the same data.
+	benchmark_label("crc8-1wire-crc16-ansi-asm", "buf");
+	crc_8 = crc8_1wire_init();
+	crc_16 = crc16_ansi_init();
+	benchmark_marker_start();
+	crc8_1wire_crc16_ansi_update_buf(test_data_b, sizeof(test_data_b), &crc_8, &crc_16);
+	benchmark_marker_end();
+
+	benchmark_label("crc16-ansi-memcpy", "buf");
+	benchmark_marker_start();
+	crc_16 = crc16_ansi_memcpy(memcpy_buf, test_data_b, sizeof(test_data_b), crc16_ansi_init());
+	benchmark_marker_end();
+
+	benchmark_label("crc16-ccitt-memcpy", "buf");
+	benchmark_marker_start();
+	crc_16 = crc16_ccitt_memcpy(memcpy_buf, test_data_b, sizeof(test_data_b), crc16_ccitt_init());
+	benchmark_marker_end();
+
+	benchmark_label("crc32-memcpy", "buf");
+	benchmark_marker_start();
+	crc_32 = crc32_memcpy(memcpy_buf, test_data_b, sizeof(test_data_b), crc32_init());
+	benchmark_marker_end();
+
+	benchmark_label("crc32-posix-memcpy", "buf");
+	benchmark_marker_start();
+	crc_32 = crc32_posix_memcpy(memcpy_buf, test_data_b, sizeof(test_data_b), crc32_posix_init());
+	benchmark_marker_end();
+
+	benchmark_label("crc32-far", "buf");
+	benchmark_marker_start();
+	crc_32 = crc32_update_far((uint16_t)test_data_b, sizeof(test_data_b), crc32_init());
+	benchmark_marker_end();
+
+	benchmark_label("crc32-posix-far", "buf");
+	benchmark_marker_start();
+	crc_32 = crc32_posix_update_far((uint16_t)test_data_b, sizeof(test_data_b), crc32_posix_init());
+	benchmark_marker_end();
+
+	benchmark_label("fletcher16-asm", "buf");
+	benchmark_marker_start();
+	crc_16 = fletcher16_update_buf(test_data_b, sizeof(test_data_b), fletcher16_init());
+	benchmark_marker_end();
+
+	benchmark_label("adler32-asm", "buf");
+	benchmark_marker_start();
+	crc_32 = adler32_update_buf(test_data_b, sizeof(test_data_b), adler32_init());
+	benchmark_marker_end();
+}
+
+void benchmark_batch(void) {
+	static uint8_t batch_8[BATCH_TEST_COUNT];
+	static uint16_t batch_16[BATCH_TEST_COUNT];
+	uint8_t crc_8;
+	uint16_t crc_16;
+
+	print_str("benchmark_batch()\n");
+	benchmark_bytes(BATCH_TEST_COUNT * BATCH_TEST_REC_LEN);
+
+	// Compare computing the CRC of each record with separate init, update and
+	// final steps versus a single batch call, for CRC8-AUTOSAR and then
+	// CRC16-CCITT.
+	benchmark_label("crc8-autosar-records", "direct");
+	benchmark_marker_start();
+	for(size_t i = 0; i < BATCH_TEST_COUNT; i++) {
+		crc_8 = crc8_autosar_init();
+		for(size_t n = 0; n < BATCH_TEST_REC_LEN; n++) {
+			crc_8 = crc8_autosar_update(crc_8, test_data_b[(i * BATCH_TEST_STRIDE) + n]);
+		}
+		batch_8[i] = crc8_autosar_final(crc_8);
+	}
+	benchmark_marker_end();
+
+	benchmark_label("crc8-autosar-batch", "buf");
+	benchmark_marker_start();
+	crc8_autosar_batch(test_data_b, BATCH_TEST_STRIDE, BATCH_TEST_REC_LEN, BATCH_TEST_COUNT, batch_8);
+	benchmark_marker_end();
+
+	benchmark_label("crc16-ccitt-records", "direct");
+	benchmark_marker_start();
+	for(size_t i = 0; i < BATCH_TEST_COUNT; i++) {
+		crc_16 = crc16_ccitt_init();
+		for(size_t n = 0; n < BATCH_TEST_REC_LEN; n++) {
+			crc_16 = crc16_ccitt_update(crc_16, test_data_b[(i * BATCH_TEST_STRIDE) + n]);
+		}
+		batch_16[i] = crc16_ccitt_final(crc_16);
+	}
+	benchmark_marker_end();
+
+	benchmark_label("crc16-ccitt-batch", "buf");
+	benchmark_marker_start();
+	crc16_ccitt_batch(test_data_b, BATCH_TEST_STRIDE, BATCH_TEST_REC_LEN, BATCH_TEST_COUNT, batch_16);
+	benchmark_marker_end();
+}
+
+void benchmark_block512(void) {
+	uint16_t crc_16;
+
+	print_str("benchmark_block512()\n");
+	benchmark_bytes(sizeof(block512_buf));
+
+	// Compare computing the CRC16-XMODEM of a 512-byte block (e.g. an SD card
+	// data block) by calling the 'update' function for each byte versus the
+	// dedicated block function.
+	benchmark_label("crc16-xmodem-asm", "direct");
+	crc_16 = crc16_xmodem_init();
+	benchmark_marker_start();
+	for(size_t i = 0; i < sizeof(block512_buf); i++) {
+		crc_16 = crc16_xmodem_update(crc_16, block512_buf[i]);
+	}
+	benchmark_marker_end();
+
+	benchmark_label("crc16-xmodem-block512", "buf");
+	benchmark_marker_start();
+	crc_16 = crc16_xmodem_block512(block512_buf);
+	benchmark_marker_end();
+}
+
+void benchmark_hash(void) {
+	const char *name = hash_test_names[HASH_TEST_COUNT - 1];
+	uint8_t index;
+
+	print_str("benchmark_hash()\n");
+	benchmark_bytes(strlen(name));
+
+	// Compare finding the last command name in the table by comparing it with
+	// each name in turn versus hashing it and looking up the hash table.
+	benchmark_label("cmd-strcmp", "direct");
+	benchmark_marker_start();
+	for(index = 0; index < HASH_TEST_COUNT; index++) {
+		if(strcmp(name, hash_test_names[index]) == 0) break;
+	}
+	benchmark_marker_end();
+
+	benchmark_label("crc-hash16-lookup", "buf");
+	benchmark_marker_start();
+	index = crc_hash16_lookup(&cmd_hash_table, crc_hash16_str(name));
+	benchmark_marker_end();
+}
+
+void benchmark_job(const size_t slice_len) {
+	crc_job_t job;
+	bool done;
+
+	print_str("benchmark_job()\n");
+
+	// Use CRC32, being the slowest type, to obtain the worst-case time taken
+	// by each slice. Every slice except the last processes the full number of
+	// bytes, so the time of each should be the same; only the first is
+	// labelled, for tools/bench.py.
+	benchmark_bytes(slice_len);
+	benchmark_label("crc32-job-step", "buf");
+	crc_job_start(&job, CRC_TYPE_CRC32, test_data_b, sizeof(test_data_b));
+
+	do {
+		benchmark_marker_start();
+		done = crc_job_step(&job, slice_len);
+		benchmark_marker_end();
+	} while(!done);
 }
 
 void main(void) {
@@ -430,6 +2597,11 @@ void main(void) {
 
 	verify();
 	benchmark(10000);
+	benchmark_update_buf();
+	benchmark_batch();
+	benchmark_block512();
+	benchmark_hash();
+	benchmark_job(32);
 
 	if(ucsim_if_detect()) {
 		ucsim_if_stop();
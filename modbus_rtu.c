@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * modbus_rtu.c - Modbus RTU frame transmit and receive
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "modbus_rtu.h"
+#include "uart.h"
+#include "uart_regs.h"
+#include "tim2_regs.h"
+#include "crc.h"
+
+// The CRC of each frame is computed byte-by-byte as it is received, so that it
+// may be checked against the residue as soon as the frame ends, rather than
+// computed over the whole frame afterwards. The end of a frame is detected by
+// a silent interval of 3.5 character times, timed by TIM2 in one-pulse mode,
+// restarted by each byte received.
+
+static uint8_t modbus_rtu_rx_buf[MODBUS_RTU_MAX_FRAME];
+static volatile size_t modbus_rtu_rx_len;
+static volatile uint16_t modbus_rtu_rx_crc;
+static volatile bool modbus_rtu_rx_error;
+static volatile modbus_rtu_rx_status_t modbus_rtu_rx_status;
+static bool modbus_rtu_rx_taken;
+
+/******************************************************************************/
+
+static void modbus_rtu_rx_reset(void) {
+	modbus_rtu_rx_len = 0;
+	modbus_rtu_rx_crc = crc16_ansi_init();
+	modbus_rtu_rx_error = false;
+	modbus_rtu_rx_taken = false;
+	modbus_rtu_rx_status = MODBUS_RTU_RX_NONE;
+}
+
+void modbus_rtu_init(const uart_baud_enum_t baud) {
+	uint32_t baud_val = uart_baud_value(baud);
+	uint32_t t35_us, ticks;
+	uint8_t psc = 0;
+
+	// Per the Modbus serial line specification, the inter-frame silence is 3.5
+	// character times (of 11 bits each), except above 19200 baud, where it is
+	// fixed at 1.75 ms.
+	t35_us = (baud_val <= 19200 ? (38500000UL / baud_val) : 1750);
+
+	// Find the smallest prescaler that gives a count fitting in 16 bits.
+	ticks = t35_us * (F_CPU / 1000000UL);
+	while(ticks > 0xFFFF) {
+		ticks >>= 1;
+		psc++;
+	}
+
+	// One-pulse mode, so the counter stops at the end of the silent interval;
+	// update interrupt only on overflow, not when the UG bit is set.
+	TIM2_CR1 = (1U << TIM2_CR1_OPM) | (1U << TIM2_CR1_URS);
+	TIM2_PSCR = psc;
+	TIM2_ARRH = (uint8_t)(ticks >> 8);
+	TIM2_ARRL = (uint8_t)ticks;
+	TIM2_EGR = (1U << TIM2_EGR_UG); // Load the prescaler.
+	TIM2_SR1 = 0;
+	TIM2_IER = (1U << TIM2_IER_UIE);
+
+	modbus_rtu_rx_reset();
+
+	UART1_CR2 |= (1U << UART1_CR2_RIEN);
+}
+
+void modbus_rtu_rx_char(const uint8_t c) {
+	// Ignore everything while a completed frame is waiting to be taken.
+	if(modbus_rtu_rx_status != MODBUS_RTU_RX_NONE) return;
+
+	// Restart the silent interval timer.
+	TIM2_CNTRH = 0;
+	TIM2_CNTRL = 0;
+	TIM2_CR1 |= (1U << TIM2_CR1_CEN);
+
+	if(modbus_rtu_rx_len < MODBUS_RTU_MAX_FRAME) {
+		modbus_rtu_rx_buf[modbus_rtu_rx_len++] = c;
+		modbus_rtu_rx_crc = crc16_ansi_update(modbus_rtu_rx_crc, c);
+	} else {
+		modbus_rtu_rx_error = true;
+	}
+}
+
+void modbus_rtu_uart_rx_isr(void) {
+	// Reading SR then DR clears the RXNE and any error flags.
+	uint8_t sr = UART1_SR;
+	uint8_t c = UART1_DR;
+
+	if(sr & ((1U << UART1_SR_OR) | (1U << UART1_SR_FE) | (1U << UART1_SR_NF) | (1U << UART1_SR_PE))) {
+		modbus_rtu_rx_error = true;
+	}
+
+	modbus_rtu_rx_char(c);
+}
+
+void modbus_rtu_timer_isr(void) {
+	TIM2_SR1 &= ~(1U << TIM2_SR1_UIF);
+
+	// The silent interval has elapsed, so the frame (if any) is complete, and
+	// its CRC has already been computed, so it can be validated immediately.
+	if(modbus_rtu_rx_len > 0) {
+		if(modbus_rtu_rx_error || modbus_rtu_rx_len < MODBUS_RTU_MIN_FRAME || modbus_rtu_rx_crc != CRC16_ANSI_RESIDUE) {
+			modbus_rtu_rx_status = MODBUS_RTU_RX_BAD;
+		} else {
+			modbus_rtu_rx_status = MODBUS_RTU_RX_OK;
+		}
+	}
+}
+
+modbus_rtu_rx_status_t modbus_rtu_receive(const uint8_t **frame, size_t *len) {
+	// Release any previously taken frame, so the next may be received.
+	if(modbus_rtu_rx_taken) modbus_rtu_rx_reset();
+
+	if(modbus_rtu_rx_status == MODBUS_RTU_RX_NONE) return MODBUS_RTU_RX_NONE;
+
+	modbus_rtu_rx_taken = true;
+	*frame = modbus_rtu_rx_buf;
+	*len = (modbus_rtu_rx_status == MODBUS_RTU_RX_OK ? modbus_rtu_rx_len - 2 : modbus_rtu_rx_len);
+
+	return modbus_rtu_rx_status;
+}
+
+void modbus_rtu_send(const uint8_t *frame, const size_t len) {
+	uint16_t crc = crc16_ansi_init();
+
+	// Compute the CRC of each byte while waiting for the previous one to be
+	// transmitted.
+	for(size_t i = 0; i < len; i++) {
+		crc = crc16_ansi_update(crc, frame[i]);
+		uart_putchar(frame[i]);
+	}
+
+	// CRC is transmitted LSB first.
+	crc = crc16_ansi_final(crc);
+	uart_putchar((uint8_t)crc);
+	uart_putchar((uint8_t)(crc >> 8));
+
+	while(!(UART1_SR & (1U << UART1_SR_TC)));
+}
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * modbus_rtu.h - Modbus RTU frame transmit and receive
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef MODBUS_RTU_H_
+#define MODBUS_RTU_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "uart.h"
+
+// Maximum size of a Modbus RTU frame (address, PDU and CRC), per the Modbus
+// serial line specification.
+#define MODBUS_RTU_MAX_FRAME 256
+
+// Minimum size of a valid frame: address, function code and CRC.
+#define MODBUS_RTU_MIN_FRAME 4
+
+typedef enum {
+	MODBUS_RTU_RX_NONE,   // No frame (yet), or still receiving one.
+	MODBUS_RTU_RX_OK,     // Frame received intact.
+	MODBUS_RTU_RX_BAD     // Frame received, but with bad CRC, length or UART error.
+} modbus_rtu_rx_status_t;
+
+// Set up TIM2 to detect the end of frames, and enable the UART receive and
+// TIM2 update interrupts. The UART must already have been initialised with
+// uart_init() for the same baud rate. The caller must provide the interrupt
+// service routines for both (see below) before enabling interrupts globally.
+extern void modbus_rtu_init(const uart_baud_enum_t baud);
+
+// Handlers to be called by the application from its interrupt service routines
+// for UART1 receive (IRQ 18 on STM8S208) and TIM2 update (IRQ 13). This module
+// does not define the ISRs itself, so the application must, e.g.:
+// void uart1_rx_isr(void) __interrupt(18) { modbus_rtu_uart_rx_isr(); }
+// void tim2_upd_isr(void) __interrupt(13) { modbus_rtu_timer_isr(); }
+extern void modbus_rtu_uart_rx_isr(void);
+extern void modbus_rtu_timer_isr(void);
+
+// Process a received byte. Called by modbus_rtu_uart_rx_isr(), but may also be
+// used directly if bytes are received by other means.
+extern void modbus_rtu_rx_char(const uint8_t c);
+
+// Get a received frame. When a frame is available, gives a pointer to it and
+// its length (not including the CRC). The frame remains valid until the next
+// call, at which point the receiver is made ready for another frame.
+extern modbus_rtu_rx_status_t modbus_rtu_receive(const uint8_t **frame, size_t *len);
+
+// Transmit a frame (address and PDU), followed by its CRC. Blocks until the
+// last byte has been completely sent (e.g. so that an RS-485 driver may then
+// be disabled).
+extern void modbus_rtu_send(const uint8_t *frame, const size_t len);
+
+#endif // MODBUS_RTU_H_
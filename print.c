@@ -0,0 +1,120 @@
+/*******************************************************************************
+ *
+ * print.c - Lightweight formatted output functions for use instead of printf
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include "print.h"
+
+// These functions output strings, and fixed-width upper-case hexadecimal and
+// unsigned decimal numbers, via putchar(). The output is identical to that of
+// printf() with the "%s", "%02X", "%04X", "%08lX" and "%lu" format specifiers
+// respectively, but the code is much smaller and faster, as SDCC's printf()
+// implementation is large and parses the format string at run-time.
+//
+// Define PRINT_USE_PRINTF to instead implement them with printf() (e.g. for
+// comparison).
+
+/******************************************************************************/
+
+#ifdef PRINT_USE_PRINTF
+
+void print_str(const char *str) {
+	printf("%s", str);
+}
+
+void print_hex8(uint8_t val) {
+	printf("%02X", val);
+}
+
+void print_hex16(uint16_t val) {
+	printf("%04X", val);
+}
+
+void print_hex32(uint32_t val) {
+	printf("%08lX", val);
+}
+
+void print_u32(uint32_t val) {
+	printf("%lu", val);
+}
+
+#else
+
+static const char print_hex_digits[16] = {
+	'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'A', 'B', 'C', 'D', 'E', 'F'
+};
+
+// Powers of ten for each decimal digit of a 32-bit value but the last. Digits
+// are found by repeated subtraction, which avoids the costly 32-bit division
+// and modulo library routines.
+static const uint32_t print_dec_powers[9] = {
+	1000000000, 100000000, 10000000, 1000000, 100000, 10000, 1000, 100, 10
+};
+
+void print_str(const char *str) {
+	while(*str != '\0') putchar(*str++);
+}
+
+void print_hex8(uint8_t val) {
+	putchar(print_hex_digits[val >> 4]);
+	putchar(print_hex_digits[val & 0x0F]);
+}
+
+void print_hex16(uint16_t val) {
+	print_hex8((uint8_t)(val >> 8));
+	print_hex8((uint8_t)val);
+}
+
+void print_hex32(uint32_t val) {
+	print_hex16((uint16_t)(val >> 16));
+	print_hex16((uint16_t)val);
+}
+
+void print_u32(uint32_t val) {
+	uint8_t digit;
+	bool leading = true;
+
+	for(uint8_t i = 0; i < (sizeof(print_dec_powers) / sizeof(print_dec_powers[0])); i++) {
+		digit = 0;
+		while(val >= print_dec_powers[i]) {
+			val -= print_dec_powers[i];
+			digit++;
+		}
+
+		// Suppress leading zeroes.
+		if(digit > 0 || !leading) {
+			putchar('0' + digit);
+			leading = false;
+		}
+	}
+
+	// Whatever remains is the last digit, which is always output.
+	putchar('0' + (uint8_t)val);
+}
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef TIM2_REGS_H_
+#define TIM2_REGS_H_
+
+// Register definitions of STM8S208 for TIM2. Note that some other devices
+// (e.g. STM8S103) have a different layout of these registers.
+
+#define TIM2_CR1 (*(volatile uint8_t *)(0x5300))
+#define TIM2_CR1_CEN 0
+#define TIM2_CR1_UDIS 1
+#define TIM2_CR1_URS 2
+#define TIM2_CR1_OPM 3
+#define TIM2_CR1_ARPE 7
+
+#define TIM2_IER (*(volatile uint8_t *)(0x5301))
+#define TIM2_IER_UIE 0
+#define TIM2_IER_CC1IE 1
+#define TIM2_IER_CC2IE 2
+#define TIM2_IER_CC3IE 3
+
+#define TIM2_SR1 (*(volatile uint8_t *)(0x5302))
+#define TIM2_SR1_UIF 0
+#define TIM2_SR1_CC1IF 1
+#define TIM2_SR1_CC2IF 2
+#define TIM2_SR1_CC3IF 3
+
+#define TIM2_EGR (*(volatile uint8_t *)(0x5304))
+#define TIM2_EGR_UG 0
+
+#define TIM2_CNTRH (*(volatile uint8_t *)(0x530A))
+#define TIM2_CNTRL (*(volatile uint8_t *)(0x530B))
+#define TIM2_PSCR (*(volatile uint8_t *)(0x530C))
+#define TIM2_ARRH (*(volatile uint8_t *)(0x530D))
+#define TIM2_ARRL (*(volatile uint8_t *)(0x530E))
+
+#endif // TIM2_REGS_H_
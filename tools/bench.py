@@ -0,0 +1,148 @@
+#!/usr/bin/env python3
+#
+# bench.py - Net cycle counts from benchmark() runs under uCsim
+#
+# Copyright (c) 2023 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# Matches the labelled runs printed by the benchmark functions of the Test
+# program with the cycle counts output by uCsim (using the timer commands in
+# sim_cmds.txt), and reports the gross and net cycles per byte for each, using
+# the number of bytes per run given by the most recent 'iterations' line. The
+# net figure has the cycles of the most recent null function run (with the
+# same method of calling) subtracted, so excludes the overhead of the call,
+# argument passing and benchmark loop. Runs of functions that process a whole
+# buffer in one call ('buf') have no null run, so their net figure is the same
+# as the gross.
+#
+# Either give a log file captured from a uCsim session, or use --run to run
+# uCsim directly. For example:
+#
+#   python3 tools/bench.py --run
+#   python3 tools/bench.py sim.log
+
+import argparse
+import re
+import subprocess
+import sys
+
+LABEL_RE = re.compile(r'^\s+(\S+) \((ptr|direct|inline|buf)\)\s*$')
+ITERS_RE = re.compile(r'^\s+iterations = (\d+)\s*$')
+# Output of "timer get benchmark", which contains the timer name followed by
+# the number of clock cycles, e.g. 'timer #1("benchmark") ON: 700017 clks'.
+TIMER_RE = re.compile(r'benchmark[^\w(].*?(\d+)')
+STOP_RE = re.compile(r'\bstop', re.IGNORECASE)
+
+def run_sim(args):
+	cmd = [args.ucsim, '-t', args.cpu, '-X', args.xtal, '-I', 'if=rom[0x5800]', '-C', args.cmds, args.image]
+	proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors='replace', bufsize=1)
+	proc.stdin.write('run\n')
+	proc.stdin.flush()
+
+	# The Test program stops the simulation when finished, so quit once that
+	# has happened after the benchmarks have started.
+	lines = []
+	started = False
+	for line in proc.stdout:
+		lines.append(line)
+		started = started or line.startswith('benchmark()')
+		if started and STOP_RE.search(line) and not TIMER_RE.search(line):
+			break
+
+	try:
+		proc.stdin.write('quit\n')
+		proc.stdin.close()
+	except BrokenPipeError:
+		pass
+	proc.wait()
+	return lines
+
+def parse(lines):
+	iters = None
+	runs = []
+	label = None
+	timer_count = 0
+
+	for line in lines:
+		m = ITERS_RE.match(line)
+		if m:
+			iters = int(m.group(1))
+			continue
+
+		m = LABEL_RE.match(line)
+		if m:
+			label = (m.group(1), m.group(2))
+			timer_count = 0
+			continue
+
+		# Each run toggles the marker pin twice, so the timer is output twice;
+		# the first value is the time since the previous marker (and is reset),
+		# the second is the time taken by the run.
+		m = TIMER_RE.search(line)
+		if m and label is not None and iters:
+			timer_count += 1
+			if timer_count == 2:
+				runs.append((label[0], label[1], int(m.group(1)), iters))
+				label = None
+
+	return runs
+
+def per_byte(runs):
+	# Gives the gross and net cycles per byte of each run, the net figure being
+	# relative to the most recent null function run with the same call method.
+	results = []
+	baseline = {}
+	for name, call, cycles, iters in runs:
+		gross = cycles / iters
+		if name.startswith('null'):
+			baseline[call] = gross
+		results.append((name, call, cycles, gross, gross - baseline.get(call, 0.0)))
+	return results
+
+def main():
+	parser = argparse.ArgumentParser(description='Report gross and net cycles per byte from benchmark() runs under uCsim.')
+	parser.add_argument('log', nargs='?', help='uCsim output log to parse')
+	parser.add_argument('--run', action='store_true', help='run uCsim rather than parsing a log')
+	parser.add_argument('--ucsim', default='ucsim_stm8', help='uCsim STM8 executable (default: %(default)s)')
+	parser.add_argument('--cpu', default='STM8S208', help='simulated device type (default: %(default)s)')
+	parser.add_argument('--xtal', default='16M', help='simulated clock frequency (default: %(default)s)')
+	parser.add_argument('--cmds', default='sim_cmds.txt', help='uCsim command file (default: %(default)s)')
+	parser.add_argument('--image', default='bin/Test/test', help='program image to run (default: %(default)s)')
+	args = parser.parse_args()
+
+	if args.run:
+		lines = run_sim(args)
+	elif args.log:
+		with open(args.log, 'r', errors='replace') as f:
+			lines = f.readlines()
+	else:
+		parser.error('either a log file or --run must be given')
+
+	runs = parse(lines)
+	if not runs:
+		sys.exit('error: no benchmark results found')
+
+	print('{:<26} {:<7} {:>11} {:>11} {:>11}'.format('Function', 'Call', 'Cycles', 'Gross/byte', 'Net/byte'))
+	for name, call, cycles, gross, net in per_byte(runs):
+		print('{:<26} {:<7} {:>11,} {:>11.2f} {:>11.2f}'.format(name, call, cycles, gross, net))
+
+if __name__ == '__main__':
+	main()
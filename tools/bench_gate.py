@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+#
+# bench_gate.py - Check benchmark cycles and code sizes against stored budgets
+#
+# Copyright (c) 2023 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# Compares the results of a benchmark() run of the Test program under uCsim
+# (see bench.py) and the code sizes of library modules with the budgets given
+# in a budget file (by default, tools/bench_budget.txt), and exits with a
+# non-zero status if any exceeds its budget by more than the tolerance. This
+# allows regressions, whether from changes to the code or from a different
+# version of SDCC, to be caught by a script or CI job on Linux after building
+# all targets.
+#
+# Module sizes are read from the object (.rel) files in each library target's
+# object output directory, and are the total of the areas that end up in flash
+# (code, constant data and initialisers), so include any lookup table.
+#
+# Budgets for which no result is found (e.g. a renamed benchmark or a target
+# that was not built) are reported as missing, and also cause failure. A budget
+# whose value is given as '-' has not been measured yet, so is reported as
+# unset, which also causes failure unless --allow-unset is given. After an
+# intentional change, or to fill in unset budgets, use --update to write the
+# measured values back to the budget file. For example:
+#
+#   python3 tools/bench_gate.py --run
+#   python3 tools/bench_gate.py --tolerance 0 sim.log
+#   python3 tools/bench_gate.py --run --update
+
+import argparse
+import os
+import re
+import sys
+
+import bench
+
+# Area definition line of an object file, e.g. "A CODE size 2D flags 0 addr 0".
+REL_AREA_RE = re.compile(r'^A\s+(\w+)\s+size\s+([0-9A-Fa-f]+)\b')
+
+# Areas whose contents are placed in flash. CRC_RAM is the code segment used
+# when building for execution from RAM (see common.h).
+FLASH_AREAS = ('CODE', 'CONST', 'INITIALIZER', 'CRC_RAM')
+
+def read_budgets(path):
+	budgets = []
+	with open(path, 'r') as f:
+		for lineno, line in enumerate(f, 1):
+			fields = line.split('#', 1)[0].split()
+			if not fields:
+				continue
+			if len(fields) != 4 or fields[0] not in ('cycles', 'size'):
+				sys.exit('error: {}:{}: malformed budget line'.format(path, lineno))
+			try:
+				budget = None if fields[3] == '-' else float(fields[3])
+			except ValueError:
+				sys.exit('error: {}:{}: malformed budget value'.format(path, lineno))
+			if budget is not None and budget <= 0:
+				sys.exit('error: {}:{}: budget must be greater than zero'.format(path, lineno))
+			budgets.append((fields[0], fields[1], fields[2], budget))
+	return budgets
+
+def module_size(path):
+	# The first line of an object file gives the radix of the numbers in it:
+	# 'X' for hexadecimal, 'D' for decimal or 'Q' for octal.
+	size = 0
+	with open(path, 'r', errors='replace') as f:
+		radix = {'X': 16, 'D': 10, 'Q': 8}.get(f.readline()[:1], 16)
+		for line in f:
+			m = REL_AREA_RE.match(line)
+			if m and m.group(1) in FLASH_AREAS:
+				size += int(m.group(2), radix)
+	return size
+
+def find_module(obj_dir, module):
+	for root, _, files in os.walk(obj_dir):
+		if module + '.rel' in files:
+			return os.path.join(root, module + '.rel')
+	return None
+
+def measure(args, budgets):
+	results = {}
+
+	if any(kind == 'cycles' for kind, _, _, _ in budgets):
+		if args.run:
+			lines = bench.run_sim(args)
+		elif args.log:
+			with open(args.log, 'r', errors='replace') as f:
+				lines = f.readlines()
+		else:
+			sys.exit('error: cycle budgets need either a log file or --run')
+
+		runs = bench.parse(lines)
+		if not runs:
+			sys.exit('error: no benchmark results found')
+		for name, call, _, gross, _ in bench.per_byte(runs):
+			results[('cycles', name, call)] = gross
+
+	for kind, a, b, _ in budgets:
+		if kind == 'size':
+			path = find_module(os.path.join(args.obj_dir, a), b)
+			if path:
+				results[('size', a, b)] = module_size(path)
+
+	return results
+
+def format_value(kind, value):
+	if value is None:
+		return '-'
+	return '{:.2f}'.format(value) if kind == 'cycles' else '{:d}'.format(int(value))
+
+def update(path, results):
+	# Rewrite only the value field of each budget line, so that comments and
+	# layout are preserved.
+	out = []
+	with open(path, 'r') as f:
+		for line in f:
+			body = line.split('#', 1)[0]
+			fields = body.split()
+			key = tuple(fields[:3])
+			if len(fields) == 4 and key in results:
+				pos = body.rindex(fields[3])
+				line = line[:pos] + format_value(fields[0], results[key]) + line[pos + len(fields[3]):]
+			out.append(line)
+	with open(path, 'w') as f:
+		f.writelines(out)
+
+def main():
+	parser = argparse.ArgumentParser(description='Check benchmark cycles per byte and library module sizes against stored budgets.')
+	parser.add_argument('log', nargs='?', help='uCsim output log to parse')
+	parser.add_argument('--run', action='store_true', help='run uCsim rather than parsing a log')
+	parser.add_argument('--budget', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'bench_budget.txt'), help='budget file (default: tools/bench_budget.txt)')
+	parser.add_argument('--tolerance', type=float, default=1.0, help='percentage by which a result may exceed its budget (default: %(default)s)')
+	parser.add_argument('--update', action='store_true', help='write the measured values to the budget file instead of checking them')
+	parser.add_argument('--allow-unset', action='store_true', help='do not fail because of budgets that have not been measured yet')
+	parser.add_argument('--obj-dir', default='obj', help='parent directory of library object output directories (default: %(default)s)')
+	parser.add_argument('--ucsim', default='ucsim_stm8', help='uCsim STM8 executable (default: %(default)s)')
+	parser.add_argument('--cpu', default='STM8S208', help='simulated device type (default: %(default)s)')
+	parser.add_argument('--xtal', default='16M', help='simulated clock frequency (default: %(default)s)')
+	parser.add_argument('--cmds', default='sim_cmds.txt', help='uCsim command file (default: %(default)s)')
+	parser.add_argument('--image', default='bin/Test/test', help='program image to run (default: %(default)s)')
+	args = parser.parse_args()
+
+	budgets = read_budgets(args.budget)
+	results = measure(args, budgets)
+
+	if args.update:
+		update(args.budget, results)
+		print('Updated {} of {} budgets in {}'.format(sum(1 for kind, a, b, _ in budgets if (kind, a, b) in results), len(budgets), args.budget))
+		return
+
+	failures = 0
+	unset = 0
+	print('{:<6} {:<26} {:<24} {:>10} {:>10} {:>8}  {}'.format('Kind', 'Name/Target', 'Call/Module', 'Budget', 'Result', 'Change', 'Status'))
+	for kind, a, b, budget in budgets:
+		result = results.get((kind, a, b))
+		if budget is None:
+			status = 'unset' if args.allow_unset else 'UNSET'
+			change = ''
+			unset += 1
+		elif result is None:
+			status = 'MISSING'
+			change = ''
+		else:
+			pct = 100.0 * (result - budget) / budget
+			status = 'FAIL' if pct > args.tolerance else 'ok'
+			change = '{:+.1f}%'.format(pct)
+		if status not in ('ok', 'unset'):
+			failures += 1
+		print('{:<6} {:<26} {:<24} {:>10} {:>10} {:>8}  {}'.format(kind, a, b, format_value(kind, budget), '' if result is None else format_value(kind, result), change, status))
+
+	print()
+	if unset:
+		print('{} budgets are unset; use --update to fill them in'.format(unset))
+	if failures:
+		sys.exit('{} of {} budgets exceeded, missing or unset (tolerance {}%)'.format(failures, len(budgets), args.tolerance))
+	print('All {} set budgets met (tolerance {}%)'.format(len(budgets) - unset, args.tolerance))
+
+if __name__ == '__main__':
+	main()
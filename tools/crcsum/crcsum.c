@@ -0,0 +1,414 @@
+/*******************************************************************************
+ *
+ * crcsum.c - Multi-threaded host CRC checksumming tool
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+// Computes the same CRCs as the STM8 library, for files on a Linux host. Each
+// file is memory-mapped and split into chunks, which are processed in parallel
+// by a pool of threads. The CRC of each chunk is computed from zero, and the
+// chunk CRCs are then merged in order using GF(2) matrix arithmetic to shift
+// the running CRC past each chunk (i.e. the same technique as zlib's
+// crc32_combine()), giving the same result as a single sequential pass.
+//
+// The byte-wise lookup tables are generated from the plain C reference
+// implementations in crc_ref.c, and the initial and XOR-out values are taken
+// from crc.h, so results are guaranteed to match those of the library.
+
+#define _GNU_SOURCE
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <getopt.h>
+#include <pthread.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+// The library header declares the STM8 assembly functions with SDCC-specific
+// keywords, which are not needed here.
+#define __naked
+#include "../../crc.h"
+#include "../../crc_ref.h"
+
+#define DEFAULT_CHUNK_SIZE (1024 * 1024)
+// Upper limit on the number of threads, whatever is given with -j. More than
+// this would gain nothing, as each thread works on whole chunks.
+#define MAX_THREADS 256
+
+typedef struct {
+	const char *name;
+	unsigned int width;
+	bool reflected;
+	uint32_t init;
+	uint32_t xorout;
+	uint32_t (*update_ref)(uint32_t crc, uint8_t data);
+	uint32_t table[256];
+	uint32_t zeros_op[32]; // Operator matrix for one zero byte.
+} algo_t;
+
+// Adapters giving all reference functions the same signature.
+static uint32_t update_crc8_1wire(uint32_t c, uint8_t d) { return crc8_1wire_update_ref((uint8_t)c, d); }
+static uint32_t update_crc8_j1850(uint32_t c, uint8_t d) { return crc8_j1850_update_ref((uint8_t)c, d); }
+static uint32_t update_crc8_autosar(uint32_t c, uint8_t d) { return crc8_autosar_update_ref((uint8_t)c, d); }
+static uint32_t update_crc16_ansi(uint32_t c, uint8_t d) { return crc16_ansi_update_ref((uint16_t)c, d); }
+static uint32_t update_crc16_ccitt(uint32_t c, uint8_t d) { return crc16_ccitt_update_ref((uint16_t)c, d); }
+static uint32_t update_crc32(uint32_t c, uint8_t d) { return crc32_update_ref(c, d); }
+static uint32_t update_crc32_posix(uint32_t c, uint8_t d) { return crc32_posix_update_ref(c, d); }
+
+static algo_t algos[] = {
+	{ .name = "crc8-1wire", .width = 8, .reflected = true, .init = CRC8_1WIRE_INIT, .xorout = CRC8_1WIRE_XOROUT, .update_ref = update_crc8_1wire },
+	{ .name = "crc8-j1850", .width = 8, .reflected = false, .init = CRC8_J1850_INIT, .xorout = CRC8_J1850_XOROUT, .update_ref = update_crc8_j1850 },
+	{ .name = "crc8-autosar", .width = 8, .reflected = false, .init = CRC8_AUTOSAR_INIT, .xorout = CRC8_AUTOSAR_XOROUT, .update_ref = update_crc8_autosar },
+	{ .name = "crc16-ansi", .width = 16, .reflected = true, .init = CRC16_ANSI_INIT, .xorout = CRC16_ANSI_XOROUT, .update_ref = update_crc16_ansi },
+	{ .name = "crc16-ccitt", .width = 16, .reflected = false, .init = CRC16_CCITT_INIT, .xorout = CRC16_CCITT_XOROUT, .update_ref = update_crc16_ccitt },
+	{ .name = "crc16-xmodem", .width = 16, .reflected = false, .init = CRC16_XMODEM_INIT, .xorout = CRC16_XMODEM_XOROUT, .update_ref = update_crc16_ccitt },
+	{ .name = "crc32", .width = 32, .reflected = true, .init = CRC32_INIT, .xorout = CRC32_XOROUT, .update_ref = update_crc32 },
+	{ .name = "crc32-posix", .width = 32, .reflected = false, .init = CRC32_POSIX_INIT, .xorout = CRC32_POSIX_XOROUT, .update_ref = update_crc32_posix }
+};
+
+#define ALGO_COUNT (sizeof(algos) / sizeof(algos[0]))
+
+/******************************************************************************/
+
+static void algo_init(algo_t *a) {
+	// Table entry is the CRC register after processing a byte from zero. For
+	// 8-bit CRCs, the table can be indexed with the XOR of CRC and data, as for
+	// reflected CRCs; for normal CRCs, the index is the top byte of the CRC.
+	for(unsigned int i = 0; i < 256; i++) {
+		a->table[i] = a->update_ref(0, (uint8_t)i);
+	}
+
+	// Each column of the operator matrix is the effect on one bit of the CRC
+	// register of processing a zero byte.
+	for(unsigned int j = 0; j < a->width; j++) {
+		a->zeros_op[j] = a->update_ref((uint32_t)1 << j, 0);
+	}
+}
+
+static inline uint32_t algo_mask(const algo_t *a) {
+	return (a->width == 32 ? 0xFFFFFFFF : ((uint32_t)1 << a->width) - 1);
+}
+
+static uint32_t algo_update(const algo_t *a, uint32_t crc, const uint8_t *data, size_t len) {
+	const uint32_t *t = a->table;
+
+	if(a->width == 8) {
+		while(len--) crc = t[(crc ^ *data++) & 0xFF];
+	} else if(a->reflected) {
+		while(len--) crc = t[(crc ^ *data++) & 0xFF] ^ (crc >> 8);
+	} else {
+		const unsigned int shift = a->width - 8;
+		const uint32_t mask = algo_mask(a);
+		while(len--) crc = (t[((crc >> shift) ^ *data++) & 0xFF] ^ (crc << 8)) & mask;
+	}
+
+	return crc;
+}
+
+/******************************************************************************/
+
+static uint32_t gf2_matrix_times(const uint32_t *mat, unsigned int width, uint32_t vec) {
+	uint32_t sum = 0;
+	for(unsigned int j = 0; vec && j < width; j++, vec >>= 1) {
+		if(vec & 1) sum ^= mat[j];
+	}
+	return sum;
+}
+
+static void gf2_matrix_square(uint32_t *square, const uint32_t *mat, unsigned int width) {
+	for(unsigned int j = 0; j < width; j++) {
+		square[j] = gf2_matrix_times(mat, width, mat[j]);
+	}
+}
+
+// Shift a CRC register value past the given number of zero bytes, in
+// O(log(len)) matrix operations.
+static uint32_t algo_shift(const algo_t *a, uint32_t crc, uint64_t len) {
+	uint32_t odd[32], even[32];
+
+	memcpy(odd, a->zeros_op, sizeof(odd));
+
+	while(len) {
+		if(len & 1) crc = gf2_matrix_times(odd, a->width, crc);
+		len >>= 1;
+		if(!len) break;
+		gf2_matrix_square(even, odd, a->width);
+		memcpy(odd, even, sizeof(odd));
+	}
+
+	return crc;
+}
+
+// Given the CRC register so far, and the CRC (computed from zero) of the
+// following chunk of data, give the CRC register after that chunk.
+static uint32_t algo_combine(const algo_t *a, uint32_t crc, uint32_t chunk_crc, uint64_t chunk_len) {
+	return algo_shift(a, crc, chunk_len) ^ chunk_crc;
+}
+
+/******************************************************************************/
+
+typedef struct {
+	const uint8_t *data;
+	size_t len;
+	size_t chunk_size;
+	size_t chunk_count;
+	size_t next_chunk;
+	const algo_t **sel;
+	size_t sel_count;
+	uint32_t *results; // [chunk][sel]
+	pthread_mutex_t lock;
+} job_t;
+
+static void *worker(void *arg) {
+	job_t *job = arg;
+
+	for(;;) {
+		size_t chunk, offset, len;
+
+		pthread_mutex_lock(&job->lock);
+		chunk = job->next_chunk++;
+		pthread_mutex_unlock(&job->lock);
+		if(chunk >= job->chunk_count) break;
+
+		offset = chunk * job->chunk_size;
+		len = (job->len - offset < job->chunk_size ? job->len - offset : job->chunk_size);
+
+		// Compute all selected algorithms for the chunk while it is hot in the
+		// cache.
+		for(size_t s = 0; s < job->sel_count; s++) {
+			job->results[(chunk * job->sel_count) + s] = algo_update(job->sel[s], 0, job->data + offset, len);
+		}
+	}
+
+	return NULL;
+}
+
+static int crcsum_buffer(const uint8_t *data, size_t len, const algo_t **sel, size_t sel_count, unsigned int threads, size_t chunk_size, uint32_t *out) {
+	job_t job = {
+		.data = data,
+		.len = len,
+		.chunk_size = chunk_size,
+		.chunk_count = (len + chunk_size - 1) / chunk_size,
+		.next_chunk = 0,
+		.sel = sel,
+		.sel_count = sel_count
+	};
+	pthread_t *tids;
+	unsigned int started = 0;
+
+	if(threads > job.chunk_count) threads = (unsigned int)job.chunk_count;
+	if(threads < 1) threads = 1;
+
+	job.results = calloc(job.chunk_count * sel_count + 1, sizeof(uint32_t));
+	if(job.results == NULL) return -1;
+	tids = calloc(threads, sizeof(pthread_t));
+	pthread_mutex_init(&job.lock, NULL);
+
+	for(; tids != NULL && started < threads; started++) {
+		if(pthread_create(&tids[started], NULL, worker, &job) != 0) break;
+	}
+	// If no threads could be started, do the work in this one.
+	if(started == 0) worker(&job);
+	for(unsigned int i = 0; i < started; i++) pthread_join(tids[i], NULL);
+
+	for(size_t s = 0; s < sel_count; s++) {
+		uint32_t crc = sel[s]->init;
+		for(size_t c = 0; c < job.chunk_count; c++) {
+			size_t chunk_len = (len - (c * chunk_size) < chunk_size ? len - (c * chunk_size) : chunk_size);
+			crc = algo_combine(sel[s], crc, job.results[(c * sel_count) + s], chunk_len);
+		}
+		out[s] = (crc ^ sel[s]->xorout) & algo_mask(sel[s]);
+	}
+
+	pthread_mutex_destroy(&job.lock);
+	free(tids);
+	free(job.results);
+	return 0;
+}
+
+static int crcsum_file(const char *path, const algo_t **sel, size_t sel_count, unsigned int threads, size_t chunk_size, uint32_t *out) {
+	struct stat st;
+	const uint8_t *data = NULL;
+	int fd, ret;
+
+	fd = open(path, O_RDONLY);
+	if(fd < 0) return -1;
+	if(fstat(fd, &st) != 0) {
+		close(fd);
+		return -1;
+	}
+
+	// Zero-length files can not be mapped, but have nothing to process anyway.
+	if(st.st_size > 0) {
+		data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if(data == MAP_FAILED) {
+			close(fd);
+			return -1;
+		}
+		madvise((void *)data, (size_t)st.st_size, MADV_SEQUENTIAL | MADV_WILLNEED);
+	}
+	close(fd);
+
+	ret = crcsum_buffer(data, (size_t)st.st_size, sel, sel_count, threads, chunk_size, out);
+
+	if(data != NULL) munmap((void *)data, (size_t)st.st_size);
+	return ret;
+}
+
+/******************************************************************************/
+
+// Check the table-driven and combining code against the reference functions
+// directly, using awkward lengths and chunk sizes.
+static int self_test(unsigned int threads) {
+	static uint8_t buf[100003];
+	const algo_t *sel[ALGO_COUNT];
+	uint32_t got[ALGO_COUNT];
+	static const size_t chunk_sizes[] = { 1, 7, 4096, 65536, sizeof(buf) };
+	int fails = 0;
+
+	srand(1);
+	for(size_t i = 0; i < sizeof(buf); i++) buf[i] = (uint8_t)rand();
+	for(size_t a = 0; a < ALGO_COUNT; a++) sel[a] = &algos[a];
+
+	for(size_t c = 0; c < (sizeof(chunk_sizes) / sizeof(chunk_sizes[0])); c++) {
+		size_t len = (chunk_sizes[c] == 1 ? 1000 : sizeof(buf));
+
+		if(crcsum_buffer(buf, len, sel, ALGO_COUNT, threads, chunk_sizes[c], got) != 0) return 1;
+
+		for(size_t a = 0; a < ALGO_COUNT; a++) {
+			uint32_t expected = algos[a].init;
+			for(size_t i = 0; i < len; i++) expected = algos[a].update_ref(expected, buf[i]);
+			expected ^= algos[a].xorout;
+			if(got[a] != expected) {
+				fprintf(stderr, "self-test: %s, chunk size %zu: got 0x%08X, expected 0x%08X\n", algos[a].name, chunk_sizes[c], got[a], expected);
+				fails++;
+			}
+		}
+	}
+
+	printf("self-test: %s\n", (fails ? "FAIL" : "PASS"));
+	return (fails ? 1 : 0);
+}
+
+static void usage(const char *prog) {
+	fprintf(stderr,
+		"Usage: %s [options] FILE...\n"
+		"Compute STM8 CRC library checksums of files.\n"
+		"\n"
+		"Options:\n"
+		"  -a ALGO   algorithm to use (may be given more than once), or 'all';\n"
+		"            default is crc32\n"
+		"  -j N      number of threads (default: number of CPUs)\n"
+		"  -c SIZE   chunk size in KB (default: %d)\n"
+		"  -l        list algorithms\n"
+		"  -t        run self-test\n"
+		"  -h        show this help\n",
+		prog, DEFAULT_CHUNK_SIZE / 1024);
+}
+
+int main(int argc, char **argv) {
+	const algo_t *sel[ALGO_COUNT];
+	size_t sel_count = 0;
+	long threads = sysconf(_SC_NPROCESSORS_ONLN);
+	size_t chunk_size = DEFAULT_CHUNK_SIZE;
+	bool test = false;
+	int opt, ret = 0;
+
+	for(size_t a = 0; a < ALGO_COUNT; a++) algo_init(&algos[a]);
+
+	while((opt = getopt(argc, argv, "a:j:c:lth")) != -1) {
+		switch(opt) {
+			case 'a':
+				if(strcmp(optarg, "all") == 0) {
+					for(size_t a = 0; a < ALGO_COUNT; a++) sel[a] = &algos[a];
+					sel_count = ALGO_COUNT;
+				} else {
+					size_t a;
+					for(a = 0; a < ALGO_COUNT && strcmp(optarg, algos[a].name) != 0; a++);
+					if(a == ALGO_COUNT) {
+						fprintf(stderr, "%s: unknown algorithm '%s' (use -l to list)\n", argv[0], optarg);
+						return 2;
+					}
+					if(sel_count < ALGO_COUNT) sel[sel_count++] = &algos[a];
+				}
+				break;
+			case 'j':
+				threads = strtol(optarg, NULL, 10);
+				break;
+			case 'c':
+				chunk_size = (size_t)strtoul(optarg, NULL, 10) * 1024;
+				break;
+			case 'l':
+				for(size_t a = 0; a < ALGO_COUNT; a++) printf("%s\n", algos[a].name);
+				return 0;
+			case 't':
+				test = true;
+				break;
+			case 'h':
+				usage(argv[0]);
+				return 0;
+			default:
+				usage(argv[0]);
+				return 2;
+		}
+	}
+
+	if(threads < 1) threads = 1;
+	if(threads > MAX_THREADS) threads = MAX_THREADS;
+	if(chunk_size == 0) chunk_size = DEFAULT_CHUNK_SIZE;
+
+	if(test) return self_test((unsigned int)threads);
+
+	if(optind >= argc) {
+		usage(argv[0]);
+		return 2;
+	}
+
+	if(sel_count == 0) {
+		for(size_t a = 0; a < ALGO_COUNT; a++) {
+			if(strcmp(algos[a].name, "crc32") == 0) sel[sel_count++] = &algos[a];
+		}
+	}
+
+	for(int i = optind; i < argc; i++) {
+		uint32_t out[ALGO_COUNT];
+
+		if(crcsum_file(argv[i], sel, sel_count, (unsigned int)threads, chunk_size, out) != 0) {
+			fprintf(stderr, "%s: %s: %s\n", argv[0], argv[i], strerror(errno));
+			ret = 1;
+			continue;
+		}
+
+		for(size_t s = 0; s < sel_count; s++) {
+			printf("%0*X  %-12s  %s\n", (int)(sel[s]->width / 4), out[s], sel[s]->name, argv[i]);
+		}
+	}
+
+	return ret;
+}
@@ -0,0 +1,189 @@
+#!/usr/bin/env python3
+#
+# hashgen.py - Generate CRC hash constants and lookup tables for sets of keys
+#
+# Copyright (c) 2023 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# Computes the hash of each key in the same way as the crc_hash16_str() or
+# crc_hash8_str() library functions (i.e. a finalised CRC16-CCITT or CRC8-
+# AUTOSAR), and outputs C code defining a constant for each hash, a constant for
+# the index of each key, and an open-addressing table for crc_hash16_lookup() or
+# crc_hash8_lookup() mapping each hash to the index of its key. Keys are given
+# on the command line or one per line in a file, and the value of each is its
+# position in the list, so handlers can be kept in an array in the same order.
+#
+# The table length is the smallest power of two that keeps the proportion of
+# slots used within --max-load. The slot at which the search for a key starts
+# depends on a seed, and every seed is tried to find the one needing the fewest
+# probes, with any collisions resolved by linear probing. With --perfect, the
+# table is instead made large enough for every key to be found on the first
+# probe. Keys with identical hashes are an error; use 16-bit hashes or rename
+# one of the keys.
+#
+# Example, for a console command table:
+#
+#   python3 tools/hashgen.py --prefix CMD help reset status version > cmd_hash.h
+#   python3 tools/hashgen.py --prefix CMD --perfect --file commands.txt -o cmd_hash.h
+
+import argparse
+import re
+import sys
+
+def crc16_ccitt(data):
+	crc = 0xFFFF
+	for b in data:
+		crc ^= b << 8
+		for _ in range(8):
+			crc = ((crc << 1) ^ 0x1021) if (crc & 0x8000) else (crc << 1)
+			crc &= 0xFFFF
+	return crc
+
+def crc8_autosar(data):
+	crc = 0xFF
+	for b in data:
+		crc ^= b
+		for _ in range(8):
+			crc = ((crc << 1) ^ 0x2F) if (crc & 0x80) else (crc << 1)
+			crc &= 0xFF
+	return crc ^ 0xFF
+
+def home_slot(h, bits, seed, size):
+	# Must match crc_hash16_lookup() and crc_hash8_lookup().
+	if bits == 16:
+		h = (h ^ (h >> 8)) & 0xFF
+	return ((h * seed) >> 8) & (size - 1)
+
+def build_table(hashes, bits, seed, size):
+	# Insert keys in order, each into the first free slot from its home slot.
+	# Gives the table (a list of key indexes, or None for empty slots) and the
+	# greatest number of probes needed to find any key.
+	table = [None] * size
+	max_probes = 0
+	for index, h in enumerate(hashes):
+		slot = home_slot(h, bits, seed, size)
+		probes = 1
+		while table[slot] is not None:
+			slot = (slot + 1) & (size - 1)
+			probes += 1
+		table[slot] = index
+		max_probes = max(max_probes, probes)
+	return table, max_probes
+
+def best_table(hashes, bits, size):
+	# Gives the seed, table and probe count of the seed needing fewest probes.
+	best = None
+	for seed in range(1, 256):
+		table, max_probes = build_table(hashes, bits, seed, size)
+		if best is None or max_probes < best[2]:
+			best = (seed, table, max_probes)
+			if max_probes == 1:
+				break
+	return best
+
+def identifier(key):
+	return re.sub(r'[^0-9A-Za-z]', '_', key.decode('ascii', 'replace')).upper()
+
+def main():
+	parser = argparse.ArgumentParser(description='Generate CRC hash constants and a lookup table for a set of keys.')
+	parser.add_argument('keys', nargs='*', help='keys to hash')
+	parser.add_argument('--file', help='file of keys, one per line (blank lines are ignored)')
+	parser.add_argument('--hex', action='store_true', help='keys are hexadecimal byte strings (e.g. 01A0FF) rather than text')
+	parser.add_argument('--bits', type=int, choices=(8, 16), default=16, help='hash width (default: %(default)s)')
+	parser.add_argument('--prefix', default='KEY', help='prefix of generated names (default: %(default)s)')
+	parser.add_argument('--max-load', type=float, default=0.75, help='greatest proportion of table slots used (default: %(default)s)')
+	parser.add_argument('--perfect', action='store_true', help='make the table large enough for every key to be found on the first probe')
+	parser.add_argument('--max-len', type=int, default=256, help='greatest table length allowed, up to 256 (default: %(default)s)')
+	parser.add_argument('-o', '--output', help='output file (default: standard output)')
+	args = parser.parse_args()
+
+	keys = list(args.keys)
+	if args.file:
+		with open(args.file, 'r') as f:
+			keys += [line.strip() for line in f if line.strip()]
+	if not keys:
+		parser.error('no keys given')
+
+	keys = [bytes.fromhex(k) if args.hex else k.encode('ascii') for k in keys]
+	if len(keys) >= 0xFF:
+		sys.exit('error: too many keys (at most 254)')
+
+	hash_func = crc16_ccitt if args.bits == 16 else crc8_autosar
+	hashes = [hash_func(k) for k in keys]
+
+	names = [identifier(k) if not args.hex else k.hex().upper() for k in keys]
+	seen = {}
+	for k, h in zip(keys, hashes):
+		if h in seen:
+			sys.exit('error: keys {!r} and {!r} have the same hash 0x{:X}'.format(seen[h], k, h))
+		seen[h] = k
+	if len(set(names)) != len(names):
+		sys.exit('error: keys do not give unique names')
+
+	# Start at the smallest table leaving at least one slot empty, which the
+	# lookup functions rely on to end an unsuccessful search.
+	size = 1
+	while size <= len(keys) or len(keys) > (size * args.max_load):
+		size *= 2
+	seed, table, max_probes = best_table(hashes, args.bits, size)
+	while args.perfect and max_probes > 1 and size < min(args.max_len, 256):
+		size *= 2
+		seed, table, max_probes = best_table(hashes, args.bits, size)
+	if size > min(args.max_len, 256) or (args.perfect and max_probes > 1):
+		sys.exit('error: no table of length {} or less found'.format(min(args.max_len, 256)))
+
+	width = args.bits // 4
+	prefix = args.prefix.upper()
+	table_name = args.prefix.lower() + '_hash_table'
+	slots_name = args.prefix.lower() + '_hash_slots'
+	slot_type = 'crc_hash{}_slot_t'.format(args.bits)
+	table_type = 'crc_hash{}_table_t'.format(args.bits)
+
+	out = []
+	out.append('// Generated by tools/hashgen.py; do not edit.')
+	out.append('// {} keys, {} slots, seed {}, at most {} probe{}.'.format(len(keys), size, seed, max_probes, '' if max_probes == 1 else 's'))
+	out.append('')
+	for name, h in zip(names, hashes):
+		out.append('#define {}_HASH_{} 0x{:0{}X}'.format(prefix, name, h, width))
+	out.append('')
+	for index, name in enumerate(names):
+		out.append('#define {}_INDEX_{} {}'.format(prefix, name, index))
+	out.append('')
+	out.append('static const {} {}[{}] = {{'.format(slot_type, slots_name, size))
+	for slot, index in enumerate(table):
+		sep = ',' if slot < (size - 1) else ''
+		if index is None:
+			out.append('\t{{ 0x{:0{}X}, CRC_HASH_EMPTY }}{}'.format(0, width, sep))
+		else:
+			out.append('\t{{ {}_HASH_{}, {}_INDEX_{} }}{}'.format(prefix, names[index], prefix, names[index], sep))
+	out.append('};')
+	out.append('')
+	out.append('static const {} {} = {{ {}, 0x{:02X}, {} }};'.format(table_type, table_name, slots_name, size - 1, seed))
+
+	text = '\n'.join(out) + '\n'
+	if args.output:
+		with open(args.output, 'w') as f:
+			f.write(text)
+	else:
+		sys.stdout.write(text)
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,150 @@
+#!/usr/bin/env python3
+#
+# image_stamp.py - Stamp a CRC32 verification trailer into an Intel HEX image
+#
+# Copyright (c) 2023 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Produces the trailer checked by crc_image_verify() (see crc.h for layout).
+# The image is taken to run from the image start address up to the highest
+# address containing data below the trailer address; any gaps are filled with
+# the fill byte (by default 0x00, being the erased state of STM8 flash), which
+# must match what the device flash will actually contain.
+#
+# Example, for an application at 0x8000 with its trailer at the start of the
+# last 1KB of flash of a 128KB device:
+#
+#   python3 tools/image_stamp.py --trailer 0x27C00 bin/Test/test.hex test-stamped.hex
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = 0x43524349 # "CRCI"
+HEADER_FORMAT = '>IIIHH'
+
+
+def read_ihex(path):
+	data = {}
+	base = 0
+	with open(path, 'r') as f:
+		for line_num, line in enumerate(f, 1):
+			line = line.strip()
+			if not line:
+				continue
+			if not line.startswith(':'):
+				raise ValueError('%s:%d: not an Intel HEX record' % (path, line_num))
+			rec = bytes.fromhex(line[1:])
+			if (sum(rec) & 0xFF) != 0:
+				raise ValueError('%s:%d: bad checksum' % (path, line_num))
+			count, addr, rtype = rec[0], (rec[1] << 8) | rec[2], rec[3]
+			payload = rec[4:4 + count]
+			if rtype == 0x00:
+				for i, b in enumerate(payload):
+					data[base + addr + i] = b
+			elif rtype == 0x01:
+				break
+			elif rtype == 0x02:
+				base = ((payload[0] << 8) | payload[1]) << 4
+			elif rtype == 0x04:
+				base = ((payload[0] << 8) | payload[1]) << 16
+			# Start address records (0x03, 0x05) are not needed and dropped.
+	return data
+
+
+def ihex_record(rtype, addr, payload):
+	rec = bytes([len(payload), (addr >> 8) & 0xFF, addr & 0xFF, rtype]) + payload
+	return ':%s%02X\n' % (rec.hex().upper(), (-sum(rec)) & 0xFF)
+
+
+def write_ihex(path, data):
+	with open(path, 'w') as f:
+		upper = None
+		addrs = sorted(data)
+		i = 0
+		while i < len(addrs):
+			start = addrs[i]
+			if (start >> 16) != upper:
+				upper = start >> 16
+				f.write(ihex_record(0x04, 0, struct.pack('>H', upper)))
+			# Gather up to 16 contiguous bytes that do not cross a 64KB boundary.
+			chunk = bytearray()
+			while i < len(addrs) and addrs[i] == start + len(chunk) and len(chunk) < 16 and (addrs[i] >> 16) == upper:
+				chunk.append(data[addrs[i]])
+				i += 1
+			f.write(ihex_record(0x00, start & 0xFFFF, bytes(chunk)))
+		f.write(ihex_record(0x01, 0, b''))
+
+
+def crc32(buf):
+	return zlib.crc32(buf) & 0xFFFFFFFF
+
+
+def main():
+	parser = argparse.ArgumentParser(description='Stamp a CRC32 verification trailer into an Intel HEX image.')
+	parser.add_argument('input', help='input Intel HEX file')
+	parser.add_argument('output', help='output Intel HEX file')
+	parser.add_argument('--image-start', type=lambda s: int(s, 0), default=0x8000, help='start address of image (default: 0x8000)')
+	parser.add_argument('--trailer', type=lambda s: int(s, 0), required=True, help='address at which to place trailer')
+	parser.add_argument('--block-size', type=lambda s: int(s, 0), default=1024, help='size of blocks for block CRC table, or 0 for none (default: 1024)')
+	parser.add_argument('--fill', type=lambda s: int(s, 0), default=0x00, help='value of unprogrammed bytes (default: 0x00)')
+	args = parser.parse_args()
+
+	if not (0 <= args.block_size <= 0xFFFF):
+		parser.error('block size must be between 0 and 65535')
+	if args.trailer <= args.image_start:
+		parser.error('trailer address must be after image start address')
+
+	data = read_ihex(args.input)
+
+	addrs = [a for a in data if args.image_start <= a < args.trailer]
+	if not addrs:
+		sys.exit('error: no data between image start and trailer address')
+	length = max(addrs) + 1 - args.image_start
+	image = bytes(data.get(args.image_start + i, args.fill) for i in range(length))
+
+	blocks = []
+	if args.block_size > 0:
+		for offset in range(0, length, args.block_size):
+			blocks.append(crc32(image[offset:offset + args.block_size]))
+
+	trailer = struct.pack(HEADER_FORMAT, MAGIC, length, crc32(image), args.block_size, len(blocks))
+	trailer += b''.join(struct.pack('>I', c) for c in blocks)
+	trailer += struct.pack('>I', crc32(trailer))
+
+	# Explicitly fill any gaps in the image, so that what is programmed is
+	# exactly what the CRC was computed over.
+	for i, b in enumerate(image):
+		data.setdefault(args.image_start + i, b)
+
+	for i, b in enumerate(trailer):
+		if (args.trailer + i) in data:
+			sys.exit('error: trailer overlaps existing data at 0x%06X' % (args.trailer + i))
+		data[args.trailer + i] = b
+
+	write_ihex(args.output, data)
+
+	print('image: 0x%06X-0x%06X (%u bytes), CRC32 0x%08X' % (args.image_start, args.image_start + length - 1, length, crc32(image)))
+	print('trailer: 0x%06X-0x%06X (%u bytes, %u blocks)' % (args.trailer, args.trailer + len(trailer) - 1, len(trailer), len(blocks)))
+
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,232 @@
+#!/usr/bin/env python3
+#
+# profile.py - Instruction-level profiler for library functions under uCsim
+#
+# Copyright (c) 2023 Basil Hussain
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+#
+# Runs the Test program in the uCsim STM8 simulator, single-stepping from a
+# given start symbol (by default the benchmark() function), and counts how many
+# times each instruction is executed. Addresses are mapped back to lines of the
+# assembler listings (.lst or .rst) of each module, using the linker map file
+# to relocate them, giving per-instruction execution counts and share of total
+# cycles. Cycle costs are the nominal ones given by the assembler in listings
+# (i.e. not accounting for pipeline stalls), so the share is an approximation.
+#
+# The listings of library functions are found in the object output directory of
+# the library build target that the Test target is linked against (by default,
+# Library (Large Fastest)). As instructions are single-stepped, profiling a
+# whole benchmark run takes a long time; use --steps to limit it.
+#
+# Example, to profile the CRC32 functions for the first 500,000 instructions
+# executed after entering the buffer benchmark:
+#
+#   python3 tools/profile.py --start _benchmark_update_buf --steps 500000 --func crc32
+
+import argparse
+import os
+import re
+import subprocess
+import sys
+import threading
+from collections import Counter, namedtuple
+
+Insn = namedtuple('Insn', ['addr', 'func', 'file', 'line', 'text', 'cycles'])
+
+# Listing line: address, code bytes, optional cycle count, line number, source.
+LST_LINE_RE = re.compile(r'^\s+([0-9A-Fa-f]{4,8})\s((?:[0-9A-Fa-f]{2}[ rsRS]?\s?)*?)\s*(?:\[\s*(\d+)\])?\s+(\d+)\s(.*)$')
+LST_LABEL_RE = re.compile(r'^\s*(_\w+)::?')
+LST_AREA_RE = re.compile(r'\s\.area\s+(\w+)')
+
+# Map file global symbol line, e.g. "     00008123  _crc32_update      crc32".
+MAP_SYM_RE = re.compile(r'^\s*(?:[A-Z]:\s+)?([0-9A-Fa-f]{6,8})\s+(_\w+)\b')
+
+# Disassembly line printed by uCsim for the next instruction after each step,
+# e.g. "   0x08123 1e 09       ldw   x,(0x09,sp)".
+SIM_PC_RE = re.compile(r'^\s*[*?>]?\s*0x([0-9a-fA-F]{4,6})\s+(?:[0-9a-fA-F]{2}\s)+')
+
+def parse_map(path):
+	symbols = {}
+	with open(path, 'r', errors='replace') as f:
+		for line in f:
+			m = MAP_SYM_RE.match(line)
+			if m:
+				symbols[m.group(2)] = int(m.group(1), 16)
+	return symbols
+
+def parse_listing(path, symbols):
+	# Addresses in a .lst file are relative to the start of each area within
+	# the module, so the offset for each area is found from the address of a
+	# global label in it compared to that in the map. In a .rst file, addresses
+	# are already absolute, so the offset works out as zero.
+	lines = []
+	offsets = {}
+	area = None
+	func = None
+
+	with open(path, 'r', errors='replace') as f:
+		for line in f:
+			# Area directive lines have no address, so must be checked first.
+			a = LST_AREA_RE.search(line)
+			if a:
+				area = a.group(1)
+				continue
+
+			m = LST_LINE_RE.match(line)
+			if not m:
+				continue
+			addr = int(m.group(1), 16)
+			code = m.group(2).strip()
+			text = m.group(5).strip()
+
+			l = LST_LABEL_RE.match(text)
+			if l:
+				func = l.group(1)
+				if func in symbols and area not in offsets:
+					offsets[area] = symbols[func] - addr
+				continue
+
+			if code:
+				cycles = int(m.group(3)) if m.group(3) else 1
+				lines.append((area, addr, func, int(m.group(4)), text, cycles))
+
+	insns = {}
+	for area, addr, func, lineno, text, cycles in lines:
+		if area in offsets:
+			insns[addr + offsets[area]] = Insn(addr + offsets[area], func, path, lineno, text, cycles)
+	return insns
+
+def find_listings(dirs):
+	paths = []
+	for d in dirs:
+		for root, _, files in os.walk(d):
+			for name in files:
+				if name.endswith('.rst') or name.endswith('.lst'):
+					paths.append(os.path.join(root, name))
+	# Prefer a .rst over the .lst of the same module, as it is already relocated.
+	stems = set(os.path.splitext(p)[0] for p in paths if p.endswith('.rst'))
+	return sorted(p for p in paths if p.endswith('.rst') or os.path.splitext(p)[0] not in stems)
+
+def run_sim(args, start_addr):
+	cmd = [args.ucsim, '-t', args.cpu, '-X', args.xtal, '-I', 'if=rom[0x5800]', args.image]
+	proc = subprocess.Popen(cmd, stdin=subprocess.PIPE, stdout=subprocess.PIPE, stderr=subprocess.STDOUT, text=True, errors='replace', bufsize=1)
+
+	def feed():
+		try:
+			proc.stdin.write('break 0x{:X}\nrun\n'.format(start_addr))
+			for _ in range(args.steps):
+				proc.stdin.write('step\n')
+			proc.stdin.write('quit\n')
+			proc.stdin.close()
+		except BrokenPipeError:
+			pass
+
+	feeder = threading.Thread(target=feed, daemon=True)
+	feeder.start()
+
+	# Only count instructions once the start breakpoint has been reached.
+	counts = Counter()
+	started = False
+	for line in proc.stdout:
+		m = SIM_PC_RE.match(line)
+		if not m:
+			continue
+		pc = int(m.group(1), 16)
+		if not started:
+			started = (pc == start_addr)
+			if not started:
+				continue
+		counts[pc] += 1
+
+	proc.wait()
+	return counts
+
+def main():
+	parser = argparse.ArgumentParser(description='Profile library functions per instruction under uCsim.')
+	parser.add_argument('--ucsim', default='ucsim_stm8', help='uCsim STM8 executable (default: %(default)s)')
+	parser.add_argument('--cpu', default='STM8S208', help='simulated device type (default: %(default)s)')
+	parser.add_argument('--xtal', default='16M', help='simulated clock frequency (default: %(default)s)')
+	parser.add_argument('--image', default='bin/Test/test', help='program image to run (default: %(default)s)')
+	parser.add_argument('--map', default='bin/Test/test.map', help='linker map file (default: %(default)s)')
+	parser.add_argument('--lst-dir', action='append', help='directory searched for .lst/.rst files; may be given more than once (default: obj/Library-Large-Fastest and obj/Test)')
+	parser.add_argument('--start', default='_benchmark', help='symbol at which to start profiling (default: %(default)s)')
+	parser.add_argument('--steps', type=int, default=1000000, help='number of instructions to step (default: %(default)s)')
+	parser.add_argument('--func', help='only report functions whose name contains this string')
+	parser.add_argument('--top', type=int, default=0, help='also list the N most expensive instructions')
+	args = parser.parse_args()
+
+	lst_dirs = args.lst_dir or ['obj/Library-Large-Fastest', 'obj/Test']
+
+	symbols = parse_map(args.map)
+	if args.start not in symbols:
+		sys.exit('error: start symbol {} not found in {}'.format(args.start, args.map))
+
+	insns = {}
+	for path in find_listings(lst_dirs):
+		insns.update(parse_listing(path, symbols))
+	if not insns:
+		sys.exit('error: no listings found in {}'.format(', '.join(lst_dirs)))
+
+	counts = run_sim(args, symbols[args.start])
+	if not counts:
+		sys.exit('error: no instructions traced (was {} reached?)'.format(args.start))
+
+	# Total cycles include instructions that could not be mapped to a listing,
+	# so that the share reported for each function is of the whole run.
+	total_cycles = sum(n * (insns[pc].cycles if pc in insns else 1) for pc, n in counts.items())
+	total_steps = sum(counts.values())
+	unmapped = sum(n for pc, n in counts.items() if pc not in insns)
+
+	funcs = {}
+	for pc, n in counts.items():
+		if pc in insns:
+			i = insns[pc]
+			if args.func and (i.func is None or args.func not in i.func):
+				continue
+			execs, cycles = funcs.get(i.func, (0, 0))
+			funcs[i.func] = (execs + n, cycles + (n * i.cycles))
+
+	print('Traced {:,} instructions, {:,} cycles ({:,} instructions not in listings)'.format(total_steps, total_cycles, unmapped))
+	print()
+	print('{:<36} {:>12} {:>12} {:>7}'.format('Function', 'Insns', 'Cycles', 'Share'))
+	for func, (execs, cycles) in sorted(funcs.items(), key=lambda f: f[1][1], reverse=True):
+		print('{:<36} {:>12,} {:>12,} {:>6.2f}%'.format(func, execs, cycles, 100.0 * cycles / total_cycles))
+
+	for func in sorted(funcs, key=lambda f: funcs[f][1], reverse=True):
+		func_insns = sorted((i for i in insns.values() if i.func == func), key=lambda i: i.addr)
+		func_cycles = funcs[func][1]
+		print()
+		print('{} ({})'.format(func, func_insns[0].file))
+		print('{:>8} {:>6} {:>12} {:>12} {:>7}  {}'.format('Addr', 'Line', 'Count', 'Cycles', 'Share', 'Instruction'))
+		for i in func_insns:
+			n = counts.get(i.addr, 0)
+			print('{:08X} {:>6} {:>12,} {:>12,} {:>6.2f}%  {}'.format(i.addr, i.line, n, n * i.cycles, (100.0 * n * i.cycles / func_cycles) if func_cycles else 0.0, i.text))
+
+	if args.top > 0:
+		hot = sorted((pc for pc in counts if pc in insns and (not args.func or (insns[pc].func and args.func in insns[pc].func))), key=lambda pc: counts[pc] * insns[pc].cycles, reverse=True)
+		print()
+		print('Top {} instructions by cycles:'.format(args.top))
+		for pc in hot[:args.top]:
+			i = insns[pc]
+			print('{:08X} {:>12,} {:>6.2f}%  {:<28} {}'.format(pc, counts[pc] * i.cycles, 100.0 * counts[pc] * i.cycles / total_cycles, i.func, i.text))
+
+if __name__ == '__main__':
+	main()
@@ -118,3 +118,11 @@ int uart_getchar(void) {
 		return UART1_DR;
 	}
 }
+
+uint32_t uart_baud_value(const uart_baud_enum_t baud) {
+	// Reconstruct the 16-bit UART divider from the BRR register values (BRR2
+	// holds the most- and least-significant nibbles, BRR1 the middle byte), and
+	// from it obtain the actual baud rate.
+	uint16_t div = ((uint16_t)(uart_baud_cfg[baud].brr2 & 0xF0) << 8) | ((uint16_t)uart_baud_cfg[baud].brr1 << 4) | (uart_baud_cfg[baud].brr2 & 0x0F);
+	return F_CPU / div;
+}
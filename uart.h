@@ -27,6 +27,8 @@
 #ifndef UART_H_
 #define UART_H_
 
+#include <stdint.h>
+
 typedef enum {
 	UART_BAUD_2400,
 	UART_BAUD_9600,
@@ -44,5 +46,6 @@ typedef int (*uart_getchar_func_t)(void);
 extern void uart_init(const uart_baud_enum_t baud, uart_putchar_func_t put_func, uart_getchar_func_t get_func);
 extern int uart_putchar(int c);
 extern int uart_getchar(void);
+extern uint32_t uart_baud_value(const uart_baud_enum_t baud);
 
 #endif // UART_H_
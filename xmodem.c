@@ -0,0 +1,268 @@
+/*******************************************************************************
+ *
+ * xmodem.c - XMODEM-CRC and XMODEM-1K double-buffered receiver
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "xmodem.h"
+#include "uart.h"
+#include "uart_regs.h"
+#include "crc.h"
+
+// Bytes are received in the UART ISR, with the CRC of each block computed as
+// its bytes arrive, so that the block can be checked (against the residue)
+// and ACK-ed as soon as its last byte has been received. Blocks are received
+// into two alternating buffers: while the block function is processing one
+// (e.g. writing it to flash) from the main loop, the next is received into the
+// other. Only when both buffers are full is the ACK of a block held back until
+// a buffer becomes free, so the sender waits.
+
+#define XMODEM_SOH 0x01
+#define XMODEM_STX 0x02
+#define XMODEM_EOT 0x04
+#define XMODEM_ACK 0x06
+#define XMODEM_NAK 0x15
+#define XMODEM_CAN 0x18
+#define XMODEM_CRC_REQ 'C'
+
+typedef enum {
+	XMODEM_RX_START,
+	XMODEM_RX_BLOCK_NUM,
+	XMODEM_RX_BLOCK_NUM_INV,
+	XMODEM_RX_DATA,
+	XMODEM_RX_CRC_MSB,
+	XMODEM_RX_CRC_LSB
+} xmodem_rx_state_t;
+
+static uint8_t xmodem_buf[2][XMODEM_BLOCK_MAX];
+static volatile size_t xmodem_buf_len[2];
+static volatile uint8_t xmodem_buf_num[2];
+static volatile bool xmodem_buf_full[2];
+static uint8_t xmodem_rx_idx;
+static uint8_t xmodem_poll_idx;
+
+static xmodem_block_func_t xmodem_block_func;
+static xmodem_rx_state_t xmodem_rx_state;
+static size_t xmodem_rx_pos;
+static size_t xmodem_rx_len;
+static uint8_t xmodem_rx_num;
+static uint8_t xmodem_rx_num_inv;
+static uint16_t xmodem_rx_crc;
+static bool xmodem_rx_store;
+static uint8_t xmodem_expected_num;
+static bool xmodem_started;
+static bool xmodem_can_received;
+
+static volatile bool xmodem_ack_pending;
+static volatile bool xmodem_eot;
+static volatile bool xmodem_cancelled;
+static volatile uint8_t xmodem_idle_ticks;
+static volatile uint8_t xmodem_retries;
+static xmodem_status_t xmodem_status;
+
+/******************************************************************************/
+
+void xmodem_init(xmodem_block_func_t block_func) {
+	xmodem_block_func = block_func;
+	xmodem_buf_full[0] = xmodem_buf_full[1] = false;
+	xmodem_rx_idx = xmodem_poll_idx = 0;
+	xmodem_rx_state = XMODEM_RX_START;
+	xmodem_expected_num = 1;
+	xmodem_started = false;
+	xmodem_can_received = false;
+	xmodem_ack_pending = false;
+	xmodem_eot = false;
+	xmodem_cancelled = false;
+	xmodem_idle_ticks = 0;
+	xmodem_retries = 0;
+	xmodem_status = XMODEM_BUSY;
+
+	UART1_CR2 |= (1U << UART1_CR2_RIEN);
+
+	// Ask the sender to start, using CRC mode.
+	uart_putchar(XMODEM_CRC_REQ);
+}
+
+static void xmodem_block_end(void) {
+	xmodem_rx_state = XMODEM_RX_START;
+
+	// With the CRC bytes included, an intact block gives the residue.
+	if(xmodem_rx_crc != CRC16_XMODEM_RESIDUE || (uint8_t)(xmodem_rx_num + xmodem_rx_num_inv) != 0xFF) {
+		xmodem_retries++;
+		uart_putchar(XMODEM_NAK);
+		return;
+	}
+
+	// An intact block that was not stored (see XMODEM_RX_BLOCK_NUM_INV) must
+	// be sent again, as it can not be delivered.
+	if(xmodem_rx_num == xmodem_expected_num && !xmodem_rx_store) {
+		xmodem_retries++;
+		uart_putchar(XMODEM_NAK);
+		return;
+	}
+
+	xmodem_retries = 0;
+
+	if(xmodem_rx_num == xmodem_expected_num) {
+		xmodem_started = true;
+		xmodem_expected_num++;
+		xmodem_buf_len[xmodem_rx_idx] = xmodem_rx_len;
+		xmodem_buf_num[xmodem_rx_idx] = xmodem_rx_num;
+		xmodem_buf_full[xmodem_rx_idx] = true;
+		xmodem_rx_idx ^= 1;
+
+		// Only ACK (allowing the sender to continue) if there is a free buffer
+		// for the next block; otherwise, xmodem_poll() will do so.
+		if(xmodem_buf_full[xmodem_rx_idx]) {
+			xmodem_ack_pending = true;
+		} else {
+			uart_putchar(XMODEM_ACK);
+		}
+	} else if(xmodem_rx_num == (uint8_t)(xmodem_expected_num - 1)) {
+		// Repeat of the previous block, because the ACK was lost, so just ACK
+		// it again, unless the ACK is being held back anyway.
+		if(!xmodem_ack_pending) uart_putchar(XMODEM_ACK);
+	} else if(xmodem_rx_num != xmodem_expected_num) {
+		// Out-of-sequence block, which can not be recovered from.
+		xmodem_cancelled = true;
+	}
+}
+
+void xmodem_rx_char(const uint8_t c) {
+	xmodem_idle_ticks = 0;
+
+	switch(xmodem_rx_state) {
+		case XMODEM_RX_START:
+			if(c == XMODEM_SOH || c == XMODEM_STX) {
+				xmodem_rx_len = (c == XMODEM_SOH ? 128 : 1024);
+				xmodem_rx_state = XMODEM_RX_BLOCK_NUM;
+			} else if(c == XMODEM_EOT) {
+				xmodem_eot = true;
+			} else if(c == XMODEM_CAN) {
+				// Two consecutive CAN characters are needed to cancel.
+				if(xmodem_can_received) xmodem_cancelled = true;
+				xmodem_can_received = true;
+				return;
+			}
+			xmodem_can_received = false;
+			break;
+		case XMODEM_RX_BLOCK_NUM:
+			xmodem_rx_num = c;
+			xmodem_rx_state = XMODEM_RX_BLOCK_NUM_INV;
+			break;
+		case XMODEM_RX_BLOCK_NUM_INV:
+			xmodem_rx_num_inv = c;
+			xmodem_rx_pos = 0;
+			xmodem_rx_crc = crc16_xmodem_init();
+			// A block larger than the buffer, or one repeated by the sender
+			// while both buffers are full, is still received so that it can
+			// be dealt with as a whole, but is not stored. Whether to store
+			// it is decided here, so that a buffer freed by xmodem_poll()
+			// part-way through does not receive only the end of the block.
+			xmodem_rx_store = (xmodem_rx_len <= XMODEM_BLOCK_MAX && !xmodem_buf_full[xmodem_rx_idx]);
+			xmodem_rx_state = XMODEM_RX_DATA;
+			break;
+		case XMODEM_RX_DATA:
+			if(xmodem_rx_store) xmodem_buf[xmodem_rx_idx][xmodem_rx_pos] = c;
+			xmodem_rx_crc = crc16_xmodem_update(xmodem_rx_crc, c);
+			if(++xmodem_rx_pos == xmodem_rx_len) xmodem_rx_state = XMODEM_RX_CRC_MSB;
+			break;
+		case XMODEM_RX_CRC_MSB:
+			xmodem_rx_crc = crc16_xmodem_update(xmodem_rx_crc, c);
+			xmodem_rx_state = XMODEM_RX_CRC_LSB;
+			break;
+		case XMODEM_RX_CRC_LSB:
+			xmodem_rx_crc = crc16_xmodem_update(xmodem_rx_crc, c);
+			if(xmodem_rx_len > XMODEM_BLOCK_MAX) xmodem_rx_crc = ~CRC16_XMODEM_RESIDUE;
+			xmodem_block_end();
+			break;
+	}
+}
+
+void xmodem_uart_rx_isr(void) {
+	// Reading SR then DR clears the RXNE and any error flags. A corrupted byte
+	// will be caught by the CRC, so errors are not checked here.
+	(void)UART1_SR;
+	xmodem_rx_char(UART1_DR);
+}
+
+void xmodem_tick(void) {
+	if(++xmodem_idle_ticks < XMODEM_TIMEOUT_TICKS) return;
+
+	xmodem_idle_ticks = 0;
+
+	// Don't time out while the sender is waiting for a deferred ACK.
+	if(xmodem_ack_pending) return;
+
+	xmodem_rx_state = XMODEM_RX_START;
+	xmodem_retries++;
+
+	// Before the first block, keep asking the sender to start; afterwards,
+	// ask for the current block to be sent again.
+	uart_putchar(xmodem_started ? XMODEM_NAK : XMODEM_CRC_REQ);
+}
+
+xmodem_status_t xmodem_poll(void) {
+	// Once the transfer has ended, keep returning the same result.
+	if(xmodem_status != XMODEM_BUSY) return xmodem_status;
+
+	if(xmodem_cancelled) return (xmodem_status = XMODEM_CANCELLED);
+
+	if(xmodem_retries >= XMODEM_MAX_RETRIES) {
+		uart_putchar(XMODEM_CAN);
+		uart_putchar(XMODEM_CAN);
+		return (xmodem_status = XMODEM_FAILED);
+	}
+
+	// Pass a completed block to the block function, while the other buffer
+	// continues to be filled by the ISR.
+	if(xmodem_buf_full[xmodem_poll_idx]) {
+		if(!xmodem_block_func(xmodem_buf[xmodem_poll_idx], xmodem_buf_len[xmodem_poll_idx], xmodem_buf_num[xmodem_poll_idx])) {
+			uart_putchar(XMODEM_CAN);
+			uart_putchar(XMODEM_CAN);
+			return (xmodem_status = XMODEM_CANCELLED);
+		}
+
+		__critical {
+			xmodem_buf_full[xmodem_poll_idx] = false;
+			if(xmodem_ack_pending) {
+				xmodem_ack_pending = false;
+				uart_putchar(XMODEM_ACK);
+			}
+		}
+
+		xmodem_poll_idx ^= 1;
+	}
+
+	// Only acknowledge the end of the transfer once all blocks have been
+	// processed.
+	if(xmodem_eot && !xmodem_buf_full[0] && !xmodem_buf_full[1]) {
+		uart_putchar(XMODEM_ACK);
+		return (xmodem_status = XMODEM_DONE);
+	}
+
+	return XMODEM_BUSY;
+}
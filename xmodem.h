@@ -0,0 +1,77 @@
+/*******************************************************************************
+ *
+ * xmodem.h - XMODEM-CRC and XMODEM-1K double-buffered receiver
+ *
+ * Copyright (c) 2023 Basil Hussain
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ ******************************************************************************/
+
+#ifndef XMODEM_H_
+#define XMODEM_H_
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+// Largest block size accepted. Set to 128 to save RAM if XMODEM-1K blocks will
+// never be sent; two buffers of this size are used.
+#ifndef XMODEM_BLOCK_MAX
+#define XMODEM_BLOCK_MAX 1024
+#endif
+
+// Number of calls to xmodem_tick() without any data received after which a
+// timeout occurs, and the number of consecutive timeouts or errors after which
+// the transfer is abandoned.
+#define XMODEM_TIMEOUT_TICKS 10
+#define XMODEM_MAX_RETRIES 10
+
+// Function called with each block received, in order. The block number is
+// the 8-bit number from the block header (so wraps around). Return false to
+// cancel the transfer (e.g. if writing to flash failed).
+typedef bool (*xmodem_block_func_t)(const uint8_t *data, size_t len, uint8_t block_num);
+
+typedef enum {
+	XMODEM_BUSY,      // Transfer in progress.
+	XMODEM_DONE,      // Transfer completed successfully.
+	XMODEM_CANCELLED, // Cancelled by the sender or the block function.
+	XMODEM_FAILED     // Too many timeouts or errors.
+} xmodem_status_t;
+
+// Start a transfer, giving the function to be called with each block. The
+// UART must already have been initialised with uart_init().
+extern void xmodem_init(xmodem_block_func_t block_func);
+
+// Handlers to be called by the application from its interrupt service
+// routine for UART1 receive (IRQ 18 on STM8S208), and at a regular interval
+// (e.g. every 100 ms from a timer interrupt) for timeouts.
+extern void xmodem_uart_rx_isr(void);
+extern void xmodem_tick(void);
+
+// Process a received byte. Called by xmodem_uart_rx_isr(), but may also be
+// used directly if bytes are received by other means.
+extern void xmodem_rx_char(const uint8_t c);
+
+// To be called repeatedly from the main loop until the result is not
+// XMODEM_BUSY. Completed blocks are passed to the block function from here,
+// while the next block is received into the other buffer.
+extern xmodem_status_t xmodem_poll(void);
+
+#endif // XMODEM_H_